@@ -0,0 +1,97 @@
+/**
+ * @file gpio_port.h
+ * @brief Salidas GPIO tipo "puerto": varios pines en una sola escritura
+ *
+ * gpio_set_level cambia un pin por llamada y valida argumentos en cada una:
+ * para un banco de reles o LEDs es lento y los pines cambian en instantes
+ * distintos. Aqui se escribe directamente en los registros W1TS (poner a 1)
+ * y W1TC (poner a 0) del ESP32, sin leer-modificar-escribir el registro de
+ * salida. Si todos los pines de la actualizacion van en el mismo sentido
+ * (gpio_port_set, gpio_port_clear, o write/toggle que solo suben o solo
+ * bajan) y estan en el mismo banco, cambian en la misma escritura de bus,
+ * sin desfase entre pines.
+ *
+ * Bancos: GPIO0-31 (registros OUT) y GPIO32-39 (OUT1). En el ESP32 del
+ * segundo banco solo GPIO32 y GPIO33 pueden ser salida (34-39 son solo
+ * entrada). Un puerto con pines en ambos bancos necesita una escritura por
+ * banco aunque todos vayan en el mismo sentido: para cambios simultaneos,
+ * usar solo GPIO0-31.
+ *
+ * - Funciones inline forzadas: se pueden llamar desde ISR en IRAM
+ * - Copia "shadow" del ultimo valor escrito: leer no toca driver ni registros
+ * - Una escritura mixta (unos pines suben y otros bajan) NO es atomica:
+ *   primero los W1TC y luego los W1TS de cada banco afectado
+ *   (break-before-make, util en puentes H y reles). El desfase entre ambas
+ *   lo mide el benchmark de main.c
+ * - Spinlock por puerto: seguro entre tareas, ISR y ambos cores
+ *
+ * El calculo de mascaras y de las escrituras de registro (gpio_port_calc_*)
+ * esta en gpio_port_masks.h.
+ */
+#pragma once
+
+#include "esp_attr.h"
+#include "gpio_port_masks.h"
+#include "soc/gpio_reg.h"
+#include "soc/soc.h"
+#include <esp_err.h>
+#include <freertos/FreeRTOS.h>
+#include <stdint.h>
+
+typedef struct {
+  uint64_t pin_mask; // Pines que pertenecen al puerto (bit n = GPIO n)
+  uint64_t shadow;   // Ultimo valor escrito en esos pines
+  portMUX_TYPE lock;
+} gpio_port_t;
+
+// Escritura en registros, en el orden que da gpio_port_calc_writes
+FORCE_INLINE_ATTR void gpio_port_write_regs(gpio_port_masks_t m) {
+  gpio_port_reg_write_t w[GPIO_PORT_MAX_WRITES];
+  int n = gpio_port_calc_writes(m, w);
+  for (int i = 0; i < n; i++) {
+    REG_WRITE(w[i].reg, w[i].value);
+  }
+}
+
+FORCE_INLINE_ATTR void gpio_port_write(gpio_port_t *port, uint64_t mask,
+                                       uint64_t value) {
+  gpio_port_masks_t m = gpio_port_calc_write(port->pin_mask, mask, value);
+  portENTER_CRITICAL_SAFE(&port->lock);
+  gpio_port_write_regs(m);
+  port->shadow = gpio_port_calc_apply(port->shadow, m);
+  portEXIT_CRITICAL_SAFE(&port->lock);
+}
+
+FORCE_INLINE_ATTR void gpio_port_set(gpio_port_t *port, uint64_t mask) {
+  gpio_port_write(port, mask, mask);
+}
+
+FORCE_INLINE_ATTR void gpio_port_clear(gpio_port_t *port, uint64_t mask) {
+  gpio_port_write(port, mask, 0);
+}
+
+FORCE_INLINE_ATTR void gpio_port_toggle(gpio_port_t *port, uint64_t mask) {
+  portENTER_CRITICAL_SAFE(&port->lock);
+  gpio_port_masks_t m =
+      gpio_port_calc_toggle(port->pin_mask, port->shadow, mask);
+  gpio_port_write_regs(m);
+  port->shadow = gpio_port_calc_apply(port->shadow, m);
+  portEXIT_CRITICAL_SAFE(&port->lock);
+}
+
+// Lectura desde la copia shadow (no toca registros ni driver). Con lock:
+// un uint64_t no se lee de forma atomica en el Xtensa de 32 bits
+FORCE_INLINE_ATTR uint64_t gpio_port_get(gpio_port_t *port) {
+  portENTER_CRITICAL_SAFE(&port->lock);
+  uint64_t value = port->shadow;
+  portEXIT_CRITICAL_SAFE(&port->lock);
+  return value;
+}
+
+/**
+ * Configura los pines de pin_mask como salida y escribe el valor inicial
+ * antes de habilitarlos (sin glitch al arrancar).
+ * Devuelve ESP_ERR_INVALID_ARG si algun pin no puede ser salida.
+ */
+esp_err_t gpio_port_init(gpio_port_t *port, uint64_t pin_mask,
+                         uint64_t initial);
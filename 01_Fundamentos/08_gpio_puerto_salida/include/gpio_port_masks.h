@@ -0,0 +1,90 @@
+/**
+ * @file gpio_port_masks.h
+ * @brief Calculo de mascaras y escrituras W1TS/W1TC para gpio_port.h
+ *
+ * Logica pura, sin acceder a registros ni FreeRTOS: compila tambien en el PC
+ * para los tests (pio test -e native), que aplican las escrituras calculadas
+ * sobre registros simulados. Inline forzado para que nunca acabe como
+ * funcion aparte en flash cuando se llama desde una ISR en IRAM, aunque se
+ * compile con optimizacion de depuracion.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#ifdef ESP_PLATFORM
+#include "esp_attr.h"
+#include "soc/gpio_reg.h"
+// Registros set/clear: GPIO0-31 en OUT, GPIO32-39 en OUT1
+#define GPIO_PORT_REG_OUT_W1TS GPIO_OUT_W1TS_REG
+#define GPIO_PORT_REG_OUT_W1TC GPIO_OUT_W1TC_REG
+#define GPIO_PORT_REG_OUT1_W1TS GPIO_OUT1_W1TS_REG
+#define GPIO_PORT_REG_OUT1_W1TC GPIO_OUT1_W1TC_REG
+#else
+#define FORCE_INLINE_ATTR static inline __attribute__((always_inline))
+// En el PC los tests los simulan: basta con identificadores distintos
+#define GPIO_PORT_REG_OUT_W1TS 0
+#define GPIO_PORT_REG_OUT_W1TC 1
+#define GPIO_PORT_REG_OUT1_W1TS 2
+#define GPIO_PORT_REG_OUT1_W1TC 3
+#endif
+
+#define GPIO_PORT_MAX_WRITES 4 // W1TC y W1TS en cada uno de los dos bancos
+
+// Pines a poner a 1 y a 0 en una actualizacion
+typedef struct {
+  uint64_t set;
+  uint64_t clr;
+} gpio_port_masks_t;
+
+// Una escritura de bus: registro y valor
+typedef struct {
+  uint32_t reg;
+  uint32_t value;
+} gpio_port_reg_write_t;
+
+// Escribir value en los pines de mask (solo los que son del puerto)
+FORCE_INLINE_ATTR gpio_port_masks_t gpio_port_calc_write(uint64_t pin_mask,
+                                                         uint64_t mask,
+                                                         uint64_t value) {
+  mask &= pin_mask;
+  return (gpio_port_masks_t){.set = value & mask, .clr = ~value & mask};
+}
+
+// Invertir los pines de mask segun el estado actual
+FORCE_INLINE_ATTR gpio_port_masks_t gpio_port_calc_toggle(uint64_t pin_mask,
+                                                          uint64_t shadow,
+                                                          uint64_t mask) {
+  mask &= pin_mask;
+  return (gpio_port_masks_t){.set = ~shadow & mask, .clr = shadow & mask};
+}
+
+// Estado resultante tras aplicar las mascaras
+FORCE_INLINE_ATTR uint64_t gpio_port_calc_apply(uint64_t shadow,
+                                                gpio_port_masks_t m) {
+  return (shadow & ~m.clr) | m.set;
+}
+
+// Escrituras de registro, en orden, que aplican las mascaras: primero W1TC
+// y luego W1TS (break-before-make), y solo en los bancos con pines a cambiar.
+// Devuelve cuantas son (0..GPIO_PORT_MAX_WRITES)
+FORCE_INLINE_ATTR int
+gpio_port_calc_writes(gpio_port_masks_t m,
+                      gpio_port_reg_write_t w[GPIO_PORT_MAX_WRITES]) {
+  int n = 0;
+  if ((uint32_t)m.clr) {
+    w[n++] = (gpio_port_reg_write_t){GPIO_PORT_REG_OUT_W1TC, (uint32_t)m.clr};
+  }
+  if (m.clr >> 32) {
+    w[n++] = (gpio_port_reg_write_t){GPIO_PORT_REG_OUT1_W1TC,
+                                     (uint32_t)(m.clr >> 32)};
+  }
+  if ((uint32_t)m.set) {
+    w[n++] = (gpio_port_reg_write_t){GPIO_PORT_REG_OUT_W1TS, (uint32_t)m.set};
+  }
+  if (m.set >> 32) {
+    w[n++] = (gpio_port_reg_write_t){GPIO_PORT_REG_OUT1_W1TS,
+                                     (uint32_t)(m.set >> 32)};
+  }
+  return n;
+}
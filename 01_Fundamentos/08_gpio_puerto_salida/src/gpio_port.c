@@ -0,0 +1,36 @@
+#include "gpio_port.h"
+#include "hal/gpio_types.h"
+#include <driver/gpio.h>
+#include <esp_log.h>
+
+static const char *TAG = "GPIO_PORT";
+
+esp_err_t gpio_port_init(gpio_port_t *port, uint64_t pin_mask,
+                         uint64_t initial) {
+  for (int pin = 0; pin < 64; pin++) {
+    if ((pin_mask & (1ULL << pin)) && !GPIO_IS_VALID_OUTPUT_GPIO(pin)) {
+      ESP_LOGE(TAG, "GPIO%d no puede configurarse como salida", pin);
+      return ESP_ERR_INVALID_ARG;
+    }
+  }
+  port->pin_mask = pin_mask;
+  port->shadow = 0;
+  portMUX_INITIALIZE(&port->lock);
+
+  // Nivel inicial en el registro de salida antes de conectar los pines
+  gpio_port_write(port, pin_mask, initial);
+
+  gpio_config_t io_conf = {.pin_bit_mask = pin_mask,
+                           .mode = GPIO_MODE_OUTPUT,
+                           .pull_down_en = GPIO_PULLDOWN_DISABLE,
+                           .pull_up_en = GPIO_PULLUP_DISABLE,
+                           .intr_type = GPIO_INTR_DISABLE};
+  esp_err_t err = gpio_config(&io_conf);
+  if (err != ESP_OK) {
+    ESP_LOGE(TAG, "Error configurando puerto: %s", esp_err_to_name(err));
+    return err;
+  }
+  ESP_LOGI(TAG, "Puerto configurado: mascara 0x%llx, valor 0x%llx", pin_mask,
+           gpio_port_get(port));
+  return ESP_OK;
+}
@@ -0,0 +1,179 @@
+/*
+Salidas tipo puerto: un banco de 4 reles/LEDs actualizado en una sola
+escritura a los registros W1TS/W1TC (ver gpio_port.h) en vez de un
+gpio_set_level por pin.
+
+- La tarea principal recorre un patron en el banco con gpio_port_write
+- Un boton de emergencia (ISR en IRAM) apaga todos los reles a la vez con
+  gpio_port_clear, sin pasar por el driver
+- Al arrancar se mide la velocidad de actualizacion y el desfase (skew)
+  entre el primer y el ultimo pin de ambos metodos
+*/
+#include "esp_attr.h"
+#include "esp_cpu.h"
+#include "freertos/projdefs.h"
+#include "gpio_port.h"
+#include "hal/gpio_types.h"
+#include <driver/gpio.h>
+#include <esp_log.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+static const char *TAG = "GPIO_PORT_DEMO";
+
+#define RELE_1 GPIO_NUM_16
+#define RELE_2 GPIO_NUM_17
+#define RELE_3 GPIO_NUM_18
+#define RELE_4 GPIO_NUM_19
+#define RELES_MASK                                                             \
+  ((1ULL << RELE_1) | (1ULL << RELE_2) | (1ULL << RELE_3) | (1ULL << RELE_4))
+#define BOTON_EMERGENCIA GPIO_NUM_39
+
+#define BENCH_ITER 10000
+
+static const gpio_num_t reles[] = {RELE_1, RELE_2, RELE_3, RELE_4};
+#define NUM_RELES (sizeof(reles) / sizeof(reles[0]))
+
+static gpio_port_t puerto_reles;
+static volatile bool sistema_seguro = true;
+
+// Apagado de todos los reles en la misma escritura de registro
+static void IRAM_ATTR isr_emergencia_handler(void *arg) {
+  gpio_port_clear(&puerto_reles, RELES_MASK);
+  sistema_seguro = false;
+}
+
+// Acumulador de una medida en ciclos: minimo (sin interrupciones de por
+// medio) y promedio
+typedef struct {
+  uint32_t min;
+  uint64_t suma;
+} medida_t;
+
+static void medida_add(medida_t *m, uint32_t ciclos) {
+  m->min = ciclos < m->min ? ciclos : m->min;
+  m->suma += ciclos;
+}
+
+// Compara gpio_set_level pin a pin contra una escritura de puerto. El
+// desfase se mide con el contador de ciclos entre las escrituras reales
+static void bench_salidas(void) {
+  const uint32_t mhz = CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ;
+  medida_t vacio = {.min = UINT32_MAX};
+  medida_t pin_total = {.min = UINT32_MAX};
+  medida_t pin_skew = {.min = UINT32_MAX};
+  medida_t puerto_total = {.min = UINT32_MAX};
+  medida_t solo_clr = {.min = UINT32_MAX};
+  medida_t mixta = {.min = UINT32_MAX};
+
+  // Coste de leer el contador dos veces seguidas: se resta a cada medida
+  for (int i = 0; i < BENCH_ITER; i++) {
+    uint32_t t0 = esp_cpu_get_cycle_count();
+    uint32_t t1 = esp_cpu_get_cycle_count();
+    medida_add(&vacio, t1 - t0);
+  }
+  const uint32_t base = vacio.min;
+
+  // 1) Un gpio_set_level por pin. Desfase: desde que vuelve la llamada del
+  //    primer pin hasta que vuelve la del ultimo
+  for (int i = 0; i < BENCH_ITER; i++) {
+    uint32_t nivel = i & 1;
+    uint32_t t0 = esp_cpu_get_cycle_count();
+    gpio_set_level(reles[0], nivel);
+    uint32_t t1 = esp_cpu_get_cycle_count();
+    for (int p = 1; p < NUM_RELES; p++) {
+      gpio_set_level(reles[p], nivel);
+    }
+    uint32_t t2 = esp_cpu_get_cycle_count();
+    medida_add(&pin_total, t2 - t0 - 2 * base);
+    medida_add(&pin_skew, t2 - t1 - base);
+  }
+
+  // 2) Todo el banco en el mismo sentido: una sola escritura, sin desfase
+  for (int i = 0; i < BENCH_ITER; i++) {
+    uint32_t t0 = esp_cpu_get_cycle_count();
+    gpio_port_write(&puerto_reles, RELES_MASK, (i & 1) ? RELES_MASK : 0);
+    uint32_t t1 = esp_cpu_get_cycle_count();
+    medida_add(&puerto_total, t1 - t0 - base);
+  }
+
+  // 3) Actualizacion mixta (un rele sube, tres bajan) con las mismas
+  //    escrituras que usa gpio_port_write. Desfase W1TC -> W1TS: lo que
+  //    tarda la secuencia mixta menos la que solo limpia
+  gpio_port_masks_t m_clr = gpio_port_calc_write(RELES_MASK, RELES_MASK, 0);
+  gpio_port_masks_t m_mixta =
+      gpio_port_calc_write(RELES_MASK, RELES_MASK, 1ULL << RELE_1);
+  for (int i = 0; i < BENCH_ITER; i++) {
+    uint32_t t0 = esp_cpu_get_cycle_count();
+    gpio_port_write_regs(m_clr);
+    uint32_t t1 = esp_cpu_get_cycle_count();
+    gpio_port_write_regs(m_mixta);
+    uint32_t t2 = esp_cpu_get_cycle_count();
+    medida_add(&solo_clr, t1 - t0 - base);
+    medida_add(&mixta, t2 - t1 - base);
+  }
+  // Volver a sincronizar la copia shadow con los registros
+  gpio_port_clear(&puerto_reles, RELES_MASK);
+
+  uint32_t ciclos_pin = (uint32_t)(pin_total.suma / BENCH_ITER);
+  uint32_t ciclos_puerto = (uint32_t)(puerto_total.suma / BENCH_ITER);
+  uint32_t gap_min = mixta.min > solo_clr.min ? mixta.min - solo_clr.min : 0;
+  uint32_t gap_medio = mixta.suma > solo_clr.suma
+                           ? (uint32_t)((mixta.suma - solo_clr.suma) /
+                                        BENCH_ITER)
+                           : 0;
+
+  ESP_LOGI(TAG, "gpio_set_level x%d: %lu ciclos/actualizacion (%lu kHz "
+           "toggle)",
+           (int)NUM_RELES, ciclos_pin, mhz * 1000 / ciclos_pin / 2);
+  ESP_LOGI(TAG, "  desfase primer-ultimo pin medido: %lu ciclos min, %lu "
+           "medio (%lu ns)",
+           pin_skew.min, (uint32_t)(pin_skew.suma / BENCH_ITER),
+           pin_skew.min * 1000 / mhz);
+  ESP_LOGI(TAG, "gpio_port_write mismo sentido: %lu ciclos/actualizacion "
+           "(%lu kHz toggle), desfase 0 (una escritura)",
+           ciclos_puerto, mhz * 1000 / ciclos_puerto / 2);
+  ESP_LOGI(TAG, "gpio_port_write mixta: desfase W1TC->W1TS medido: %lu "
+           "ciclos min, %lu medio (%lu ns)",
+           gap_min, gap_medio, gap_min * 1000 / mhz);
+}
+
+void tarea_reles(void *pvParameters) {
+  uint32_t paso = 0;
+  while (true) {
+    if (sistema_seguro) {
+      // Patron de corrimiento: un rele encendido a la vez. Es una
+      // actualizacion mixta (uno sube, otro baja): primero W1TC y luego
+      // W1TS, con el desfase que mide bench_salidas
+      gpio_port_write(&puerto_reles, RELES_MASK,
+                      1ULL << reles[paso % NUM_RELES]);
+      ESP_LOGI(TAG, "Reles: 0x%llx", gpio_port_get(&puerto_reles));
+      paso++;
+      vTaskDelay(pdMS_TO_TICKS(500));
+    } else {
+      printf("Reles apagados por emergencia!!!!\n");
+      vTaskDelay(pdMS_TO_TICKS(2000));
+      sistema_seguro = true;
+      printf("Reanudando secuencia\n");
+    }
+  }
+}
+
+void app_main() {
+  ESP_ERROR_CHECK(gpio_port_init(&puerto_reles, RELES_MASK, 0));
+  bench_salidas();
+
+  gpio_config_t io_conf = {.intr_type = GPIO_INTR_NEGEDGE,
+                           .mode = GPIO_MODE_INPUT,
+                           .pin_bit_mask = (1ULL << BOTON_EMERGENCIA),
+                           .pull_down_en = GPIO_PULLDOWN_DISABLE,
+                           .pull_up_en = GPIO_PULLUP_DISABLE};
+  gpio_config(&io_conf);
+  gpio_install_isr_service(0);
+  gpio_isr_handler_add(BOTON_EMERGENCIA, isr_emergencia_handler, NULL);
+
+  xTaskCreate(tarea_reles, "Tarea Reles", 4096, NULL, 5, NULL);
+}
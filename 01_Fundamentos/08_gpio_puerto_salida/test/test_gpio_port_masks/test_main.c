@@ -0,0 +1,234 @@
+// Tests en el PC del calculo de mascaras de gpio_port (pio test -e native).
+// Las escrituras W1TS/W1TC de gpio_port_calc_writes (las mismas que hace
+// gpio_port_write_regs) se aplican sobre registros OUT/OUT1 simulados
+#include "gpio_port_masks.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <unity.h>
+
+#define PIN(n) (1ULL << (n))
+#define PUERTO (PIN(16) | PIN(17) | PIN(18) | PIN(19) | PIN(33))
+#define AJENOS (PIN(2) | PIN(21) | PIN(32)) // Pines de otros perifericos
+
+// Registros simulados: OUT (GPIO0-31) y OUT1 (GPIO32-39)
+static uint32_t reg_out;
+static uint32_t reg_out1;
+// Escrituras de la ultima actualizacion, en orden
+static gpio_port_reg_write_t escrituras[GPIO_PORT_MAX_WRITES];
+static int num_escrituras;
+static uint64_t shadow;
+
+void setUp(void) {
+  reg_out = (uint32_t)AJENOS;
+  reg_out1 = (uint32_t)(AJENOS >> 32);
+  shadow = 0;
+}
+
+void tearDown(void) {}
+
+static uint64_t leer_out(void) {
+  return ((uint64_t)reg_out1 << 32) | reg_out;
+}
+
+// Aplica las escrituras que haria gpio_port_write_regs
+static void aplicar(gpio_port_masks_t m) {
+  num_escrituras = gpio_port_calc_writes(m, escrituras);
+  for (int i = 0; i < num_escrituras; i++) {
+    uint32_t v = escrituras[i].value;
+    switch (escrituras[i].reg) {
+    case GPIO_PORT_REG_OUT_W1TS:
+      reg_out |= v;
+      break;
+    case GPIO_PORT_REG_OUT_W1TC:
+      reg_out &= ~v;
+      break;
+    case GPIO_PORT_REG_OUT1_W1TS:
+      reg_out1 |= v;
+      break;
+    case GPIO_PORT_REG_OUT1_W1TC:
+      reg_out1 &= ~v;
+      break;
+    default:
+      TEST_FAIL_MESSAGE("registro desconocido");
+    }
+  }
+  shadow = gpio_port_calc_apply(shadow, m);
+}
+
+static bool es_w1tc(uint32_t reg) {
+  return reg == GPIO_PORT_REG_OUT_W1TC || reg == GPIO_PORT_REG_OUT1_W1TC;
+}
+
+static void escribir(uint64_t mask, uint64_t value) {
+  aplicar(gpio_port_calc_write(PUERTO, mask, value));
+}
+
+static void invertir(uint64_t mask) {
+  aplicar(gpio_port_calc_toggle(PUERTO, shadow, mask));
+}
+
+// Los pines del puerto coinciden con la shadow y los ajenos no cambian
+static void comprobar_registro(void) {
+  TEST_ASSERT_EQUAL_HEX64(shadow, leer_out() & PUERTO);
+  TEST_ASSERT_EQUAL_HEX64(AJENOS, leer_out() & ~PUERTO);
+}
+
+void test_set_and_clear(void) {
+  escribir(PIN(16) | PIN(18), PIN(16) | PIN(18)); // set
+  TEST_ASSERT_EQUAL_HEX64(PIN(16) | PIN(18), shadow);
+  TEST_ASSERT_EQUAL_INT(1, num_escrituras);
+  comprobar_registro();
+
+  escribir(PIN(16), 0); // clear
+  TEST_ASSERT_EQUAL_HEX64(PIN(18), shadow);
+  TEST_ASSERT_EQUAL_INT(1, num_escrituras);
+  comprobar_registro();
+}
+
+void test_write_only_touches_mask(void) {
+  escribir(PUERTO, PUERTO);
+  escribir(PIN(17) | PIN(18), PIN(18)); // 17 baja, 18 sigue alto
+  TEST_ASSERT_EQUAL_HEX64(PUERTO & ~PIN(17), shadow);
+  comprobar_registro();
+
+  // Bits de value fuera de mask se ignoran
+  escribir(PIN(17), PIN(17) | PIN(16));
+  TEST_ASSERT_EQUAL_HEX64(PUERTO, shadow);
+  comprobar_registro();
+}
+
+void test_pin_mask_filters_foreign_pins(void) {
+  gpio_port_masks_t m = gpio_port_calc_write(PUERTO, ~0ULL, 0);
+  TEST_ASSERT_EQUAL_HEX64(PUERTO, m.clr);
+  TEST_ASSERT_EQUAL_HEX64(0, m.set);
+
+  m = gpio_port_calc_write(PUERTO, ~0ULL, ~0ULL);
+  TEST_ASSERT_EQUAL_HEX64(PUERTO, m.set);
+  TEST_ASSERT_EQUAL_HEX64(0, m.clr);
+
+  m = gpio_port_calc_toggle(PUERTO, 0, AJENOS);
+  TEST_ASSERT_EQUAL_HEX64(0, m.set | m.clr);
+
+  escribir(AJENOS, 0); // Intentar apagar pines ajenos no hace nada
+  TEST_ASSERT_EQUAL_INT(0, num_escrituras);
+  comprobar_registro();
+}
+
+void test_toggle(void) {
+  escribir(PIN(16) | PIN(17), PIN(16)); // 16 alto, 17 bajo
+  invertir(PIN(16) | PIN(17));
+  TEST_ASSERT_EQUAL_HEX64(PIN(17), shadow);
+  comprobar_registro();
+
+  invertir(PIN(16) | PIN(17));
+  TEST_ASSERT_EQUAL_HEX64(PIN(16), shadow);
+  comprobar_registro();
+
+  // Dos toggles seguidos dejan el puerto como estaba
+  uint64_t antes = shadow;
+  invertir(PUERTO);
+  invertir(PUERTO);
+  TEST_ASSERT_EQUAL_HEX64(antes, shadow);
+  comprobar_registro();
+}
+
+void test_high_bank_uses_out1(void) {
+  escribir(PIN(33), PIN(33));
+  TEST_ASSERT_EQUAL_HEX32(PIN(33) >> 32, reg_out1 & (PUERTO >> 32));
+  TEST_ASSERT_EQUAL_HEX32(0, reg_out & (uint32_t)PUERTO);
+  comprobar_registro();
+
+  // Mixta entre bancos (16 sube, 33 baja): W1TC de OUT1 y W1TS de OUT
+  escribir(PIN(16) | PIN(33), PIN(16));
+  TEST_ASSERT_EQUAL_HEX64(PIN(16), shadow);
+  TEST_ASSERT_EQUAL_INT(2, num_escrituras);
+  TEST_ASSERT_EQUAL_UINT32(GPIO_PORT_REG_OUT1_W1TC, escrituras[0].reg);
+  TEST_ASSERT_EQUAL_UINT32(GPIO_PORT_REG_OUT_W1TS, escrituras[1].reg);
+  comprobar_registro();
+}
+
+void test_same_direction_across_banks_is_two_writes(void) {
+  // Mismo sentido pero en ambos bancos: una escritura por registro, no una
+  escribir(PIN(16) | PIN(33), PIN(16) | PIN(33));
+  TEST_ASSERT_EQUAL_INT(2, num_escrituras);
+  TEST_ASSERT_EQUAL_UINT32(GPIO_PORT_REG_OUT_W1TS, escrituras[0].reg);
+  TEST_ASSERT_EQUAL_HEX32(PIN(16), escrituras[0].value);
+  TEST_ASSERT_EQUAL_UINT32(GPIO_PORT_REG_OUT1_W1TS, escrituras[1].reg);
+  TEST_ASSERT_EQUAL_HEX32(PIN(33) >> 32, escrituras[1].value);
+  comprobar_registro();
+
+  escribir(PIN(16) | PIN(33), 0);
+  TEST_ASSERT_EQUAL_INT(2, num_escrituras);
+  TEST_ASSERT_EQUAL_UINT32(GPIO_PORT_REG_OUT_W1TC, escrituras[0].reg);
+  TEST_ASSERT_EQUAL_UINT32(GPIO_PORT_REG_OUT1_W1TC, escrituras[1].reg);
+  comprobar_registro();
+
+  // Mismo sentido en un solo banco: una unica escritura
+  escribir(PIN(16) | PIN(17) | PIN(18) | PIN(19), PUERTO);
+  TEST_ASSERT_EQUAL_INT(1, num_escrituras);
+  TEST_ASSERT_EQUAL_HEX32(PIN(16) | PIN(17) | PIN(18) | PIN(19),
+                          escrituras[0].value);
+  comprobar_registro();
+}
+
+void test_mixed_update_is_disjoint(void) {
+  // Un pin sube y otro baja: W1TC y W1TS, nunca el mismo pin en ambas
+  escribir(PIN(16), PIN(16));
+  gpio_port_masks_t m = gpio_port_calc_write(PUERTO, PIN(16) | PIN(17),
+                                             PIN(17));
+  TEST_ASSERT_EQUAL_HEX64(0, m.set & m.clr);
+  TEST_ASSERT_EQUAL_HEX64(PIN(17), m.set);
+  TEST_ASSERT_EQUAL_HEX64(PIN(16), m.clr);
+  aplicar(m);
+  TEST_ASSERT_EQUAL_INT(2, num_escrituras);
+  // Break-before-make: el W1TC va antes que el W1TS
+  TEST_ASSERT_EQUAL_UINT32(GPIO_PORT_REG_OUT_W1TC, escrituras[0].reg);
+  TEST_ASSERT_EQUAL_HEX32(PIN(16), escrituras[0].value);
+  TEST_ASSERT_EQUAL_UINT32(GPIO_PORT_REG_OUT_W1TS, escrituras[1].reg);
+  TEST_ASSERT_EQUAL_HEX32(PIN(17), escrituras[1].value);
+  TEST_ASSERT_EQUAL_HEX64(PIN(17), shadow);
+  comprobar_registro();
+
+  m = gpio_port_calc_toggle(PUERTO, shadow, PUERTO);
+  TEST_ASSERT_EQUAL_HEX64(0, m.set & m.clr);
+  TEST_ASSERT_EQUAL_HEX64(PUERTO, m.set | m.clr);
+}
+
+// Secuencia pseudoaleatoria de operaciones contra un modelo de referencia
+void test_random_sequence_matches_model(void) {
+  uint32_t semilla = 12345;
+  uint64_t modelo = 0;
+  for (int i = 0; i < 1000; i++) {
+    semilla = semilla * 1103515245u + 12345u;
+    uint64_t mask = ((uint64_t)semilla << 24) ^ semilla;
+    semilla = semilla * 1103515245u + 12345u;
+    uint64_t value = ((uint64_t)semilla << 20) ^ semilla;
+    if (semilla & 0x10000) {
+      invertir(mask);
+      modelo ^= mask & PUERTO;
+    } else {
+      escribir(mask, value);
+      modelo = (modelo & ~(mask & PUERTO)) | (value & mask & PUERTO);
+    }
+    TEST_ASSERT_EQUAL_HEX64(modelo, shadow);
+    comprobar_registro();
+    // Todos los W1TC antes del primer W1TS
+    for (int k = 1; k < num_escrituras; k++) {
+      TEST_ASSERT_TRUE(es_w1tc(escrituras[k - 1].reg) ||
+                       !es_w1tc(escrituras[k].reg));
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_set_and_clear);
+  RUN_TEST(test_write_only_touches_mask);
+  RUN_TEST(test_pin_mask_filters_foreign_pins);
+  RUN_TEST(test_toggle);
+  RUN_TEST(test_high_bank_uses_out1);
+  RUN_TEST(test_same_direction_across_banks_is_two_writes);
+  RUN_TEST(test_mixed_update_is_disjoint);
+  RUN_TEST(test_random_sequence_matches_model);
+  return UNITY_END();
+}
@@ -0,0 +1,74 @@
+/**
+ * @file report_by_exception.h
+ * @brief Filtro "report by exception" para publicar solo lecturas
+ * significativas
+ *
+ * Se coloca entre la adquisicion (read_dht22_sensor) y el envio (MQTT). Cada
+ * canal (temperatura, humedad, ...) tiene su propia configuracion:
+ *   - Banda muerta absoluta y/o porcentual respecto al ultimo valor reportado
+ *   - Silencio maximo (heartbeat): se reporta aunque no haya cambios
+ *   - Compresion swinging door opcional para series temporales: se descartan
+ *     los puntos que la interpolacion lineal entre puntos reportados ya
+ *     reconstruye dentro de la banda muerta
+ *
+ * Garantia: reconstruyendo por interpolacion lineal entre los puntos
+ * emitidos (modo swinging door) o manteniendo el ultimo valor (modo banda
+ * muerta), el error respecto a cada lectura original no supera la banda.
+ *
+ * C puro, sin dependencias de ESP-IDF.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define RBE_MAX_OUT 2 // Puntos que puede emitir una sola lectura
+
+typedef struct {
+  float abs_deadband; // Cambio absoluto minimo (0 = deshabilitado)
+  float pct_deadband; // Cambio minimo en % del ultimo valor (0 = deshab.)
+  uint64_t max_silence_us; // Heartbeat: maximo sin reportar (0 = deshab.)
+  bool swinging_door;      // true = compresion swinging door
+} rbe_channel_cfg_t;
+
+typedef struct {
+  float value;
+  uint64_t timestamp; // us
+} rbe_point_t;
+
+typedef struct {
+  rbe_channel_cfg_t cfg;
+  bool has_archived;
+  rbe_point_t archived; // Ultimo punto emitido
+  // Estado swinging door: punto retenido y corredor de pendientes admisibles
+  bool has_held;
+  rbe_point_t held;
+  float slope_lo;
+  float slope_hi;
+  // Estadisticas
+  uint32_t received;  // Lecturas aceptadas
+  uint32_t emitted;
+  uint32_t discarded; // Lecturas con timestamp no creciente
+} rbe_channel_t;
+
+void rbe_channel_init(rbe_channel_t *ch, const rbe_channel_cfg_t *cfg);
+
+/**
+ * Procesa una lectura. Escribe en out los puntos a publicar (en orden
+ * cronologico) y devuelve cuantos son (0..RBE_MAX_OUT).
+ * Las lecturas con timestamp no creciente se descartan y se cuentan en
+ * discarded, no en received.
+ */
+int rbe_process(rbe_channel_t *ch, float value, uint64_t timestamp,
+                rbe_point_t out[RBE_MAX_OUT]);
+
+/**
+ * Emite el punto retenido por swinging door (llamar antes de apagar).
+ * Devuelve true si habia un punto pendiente.
+ */
+bool rbe_flush(rbe_channel_t *ch, rbe_point_t *out);
+
+/**
+ * Lecturas aceptadas por cada punto emitido (1.0 = sin reduccion).
+ */
+float rbe_reduction_ratio(const rbe_channel_t *ch);
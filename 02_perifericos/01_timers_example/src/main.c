@@ -12,6 +12,7 @@ default).
 #include "esp_system.h"
 #include "freertos/projdefs.h"
 #include "reent.h"
+#include "report_by_exception.h"
 #include "string.h"
 #include <driver/gpio.h>
 #include <esp_log.h>
@@ -32,6 +33,19 @@ static esp_timer_handle_t sensor_timer = NULL;
 // Cola FreeRTOS para enviar datos leidos
 static QueueHandle_t data_queue = NULL;
 
+// Report by exception: solo se publican cambios significativos por canal
+#define TEMP_DEADBAND_C 0.3f
+#define HUM_DEADBAND_PCT 2.0f
+#define MAX_SILENCE_US (10ULL * 60 * 1000000) // Heartbeat cada 10 minutos
+#define RBE_STATS_EVERY 15                    // Lecturas entre estadisticas
+static rbe_channel_t rbe_temperature;
+static rbe_channel_t rbe_humidity;
+// Marca de fin de datos: la tarea de proceso vacia la cola, publica lo
+// retenido y avisa a quien pidio el apagado
+#define SENSOR_DATA_END UINT64_MAX
+static TaskHandle_t process_task_handle = NULL;
+static TaskHandle_t shutdown_waiter = NULL;
+
 // Estrucutra de datos del sensor
 typedef struct {
   float temperature;
@@ -93,16 +107,64 @@ static esp_err_t init_sensor_monitoring(void) {
   return ESP_OK;
   // FUncion de ejemplo para una tarea FreeRTOS que procesa la cola
 }
+// Publicacion de un punto significativo
+static void publish_point(const char *topic, const rbe_point_t *p) {
+  ESP_LOGI(TAG, "Publicando %s: %.2f (TS=%llu)", topic, p->value,
+           p->timestamp);
+  // En real: mqtt_publish(topic, p)
+}
 static void procces_data_task(void *arg) {
   sensor_data_t data;
+  rbe_point_t out[RBE_MAX_OUT];
+  // Temperatura con swinging door (serie suave), humedad con banda en %
+  const rbe_channel_cfg_t temp_cfg = {.abs_deadband = TEMP_DEADBAND_C,
+                                      .max_silence_us = MAX_SILENCE_US,
+                                      .swinging_door = true};
+  const rbe_channel_cfg_t hum_cfg = {.pct_deadband = HUM_DEADBAND_PCT,
+                                     .max_silence_us = MAX_SILENCE_US,
+                                     .swinging_door = false};
+  rbe_channel_init(&rbe_temperature, &temp_cfg);
+  rbe_channel_init(&rbe_humidity, &hum_cfg);
+  uint32_t lecturas = 0; // Incluye las descartadas por el filtro
   for (;;) {
     if (xQueueReceive(data_queue, &data, portMAX_DELAY) == pdPASS) {
+      if (data.timestamp == SENSOR_DATA_END) {
+        break; // Todas las lecturas anteriores ya se procesaron
+      }
       // Procesar enviar, loggear, etc.
       ESP_LOGD(TAG, "Procesando: Temp=%.1f,Hum=%.1f", data.temperature,
                data.humidity);
-      // En real: mqtt_publish("/sensor/data",&data)
+      int n = rbe_process(&rbe_temperature, data.temperature, data.timestamp,
+                          out);
+      for (int i = 0; i < n; i++) {
+        publish_point("/sensor/temperature", &out[i]);
+      }
+      n = rbe_process(&rbe_humidity, data.humidity, data.timestamp, out);
+      for (int i = 0; i < n; i++) {
+        publish_point("/sensor/humidity", &out[i]);
+      }
+      if (++lecturas % RBE_STATS_EVERY == 0) {
+        ESP_LOGI(TAG, "Reduccion: temp %.1fx (%lu/%lu), hum %.1fx (%lu/%lu)",
+                 rbe_reduction_ratio(&rbe_temperature),
+                 rbe_temperature.received, rbe_temperature.emitted,
+                 rbe_reduction_ratio(&rbe_humidity), rbe_humidity.received,
+                 rbe_humidity.emitted);
+      }
     }
   }
+  // Publicar los ultimos puntos retenidos por swinging door
+  if (rbe_flush(&rbe_temperature, &out[0])) {
+    publish_point("/sensor/temperature", &out[0]);
+  }
+  if (rbe_flush(&rbe_humidity, &out[0])) {
+    publish_point("/sensor/humidity", &out[0]);
+  }
+  ESP_LOGI(TAG, "Reduccion final: temp %.1fx, hum %.1fx (%lu descartadas)",
+           rbe_reduction_ratio(&rbe_temperature),
+           rbe_reduction_ratio(&rbe_humidity), rbe_temperature.discarded);
+  process_task_handle = NULL;
+  xTaskNotifyGive(shutdown_waiter);
+  vTaskDelete(NULL);
 }
 // Limpieza (llamar en shutdown o error)
 static void deinit_sensor_monitoring(void) {
@@ -111,6 +173,13 @@ static void deinit_sensor_monitoring(void) {
     esp_timer_delete(sensor_timer);
     sensor_timer = NULL;
   }
+  // La tarea de proceso termina de vaciar la cola antes de borrarla
+  if (process_task_handle != NULL && data_queue != NULL) {
+    shutdown_waiter = xTaskGetCurrentTaskHandle();
+    sensor_data_t end = {.timestamp = SENSOR_DATA_END};
+    xQueueSend(data_queue, &end, portMAX_DELAY);
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  }
   if (data_queue != NULL) {
     vQueueDelete(data_queue);
     data_queue = NULL;
@@ -126,7 +195,8 @@ void app_main() {
     ESP_LOGE(TAG, "Fallo en inicializacion - reiniciando");
     esp_restart();
   }
-  xTaskCreate(procces_data_task, "process_task", 4096, NULL, 5, NULL);
+  xTaskCreate(procces_data_task, "process_task", 4096, NULL, 5,
+              &process_task_handle);
   // Ejemplo: Detner despues de 1 minuto (para demo)
   vTaskDelay(pdMS_TO_TICKS(60000));
   deinit_sensor_monitoring();
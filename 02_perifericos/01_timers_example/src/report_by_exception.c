@@ -0,0 +1,96 @@
+#include "report_by_exception.h"
+#include <math.h>
+#include <string.h>
+
+void rbe_channel_init(rbe_channel_t *ch, const rbe_channel_cfg_t *cfg) {
+  memset(ch, 0, sizeof(*ch));
+  ch->cfg = *cfg;
+}
+
+// Banda muerta efectiva: la mayor de las configuradas (absoluta o % del
+// ultimo valor reportado)
+static float deadband(const rbe_channel_t *ch) {
+  float pct = ch->cfg.pct_deadband * fabsf(ch->archived.value) / 100.0f;
+  return pct > ch->cfg.abs_deadband ? pct : ch->cfg.abs_deadband;
+}
+
+static void archive(rbe_channel_t *ch, rbe_point_t p, rbe_point_t *out,
+                    int *n) {
+  ch->archived = p;
+  ch->has_archived = true;
+  ch->has_held = false;
+  ch->emitted++;
+  out[(*n)++] = p;
+}
+
+static bool heartbeat_due(const rbe_channel_t *ch, uint64_t timestamp) {
+  return ch->cfg.max_silence_us > 0 &&
+         timestamp - ch->archived.timestamp >= ch->cfg.max_silence_us;
+}
+
+int rbe_process(rbe_channel_t *ch, float value, uint64_t timestamp,
+                rbe_point_t out[RBE_MAX_OUT]) {
+  rbe_point_t p = {.value = value, .timestamp = timestamp};
+  int n = 0;
+
+  if (!ch->has_archived) {
+    ch->received++;
+    archive(ch, p, out, &n); // Primer punto siempre se reporta
+    return n;
+  }
+  uint64_t last_ts = ch->has_held ? ch->held.timestamp : ch->archived.timestamp;
+  if (timestamp <= last_ts) {
+    ch->discarded++; // No cuenta como recibida: no infla la reduccion
+    return 0;
+  }
+  ch->received++;
+
+  if (!ch->cfg.swinging_door) {
+    if (fabsf(value - ch->archived.value) > deadband(ch) ||
+        heartbeat_due(ch, timestamp)) {
+      archive(ch, p, out, &n);
+    }
+    return n;
+  }
+
+  // Swinging door: el corredor [slope_lo, slope_hi] contiene las pendientes
+  // desde el punto archivado que pasan a +-banda de todos los puntos
+  // retenidos. Si la recta archivado->P se sale, el retenido se emite.
+  float dt = (timestamp - ch->archived.timestamp) / 1e6f;
+  float slope = (value - ch->archived.value) / dt;
+  if (ch->has_held && (slope < ch->slope_lo || slope > ch->slope_hi)) {
+    archive(ch, ch->held, out, &n);
+    dt = (timestamp - ch->archived.timestamp) / 1e6f;
+  }
+
+  float dev = deadband(ch);
+  float lo = (value - dev - ch->archived.value) / dt;
+  float hi = (value + dev - ch->archived.value) / dt;
+  if (!ch->has_held) {
+    ch->slope_lo = lo;
+    ch->slope_hi = hi;
+  } else {
+    ch->slope_lo = lo > ch->slope_lo ? lo : ch->slope_lo;
+    ch->slope_hi = hi < ch->slope_hi ? hi : ch->slope_hi;
+  }
+  ch->held = p;
+  ch->has_held = true;
+
+  if (heartbeat_due(ch, timestamp)) {
+    archive(ch, p, out, &n);
+  }
+  return n;
+}
+
+bool rbe_flush(rbe_channel_t *ch, rbe_point_t *out) {
+  if (!ch->has_held) {
+    return false;
+  }
+  int n = 0;
+  archive(ch, ch->held, out, &n);
+  return true;
+}
+
+float rbe_reduction_ratio(const rbe_channel_t *ch) {
+  return ch->emitted > 0 ? (float)ch->received / ch->emitted : 1.0f;
+}
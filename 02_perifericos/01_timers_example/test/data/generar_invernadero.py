@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+"""Genera invernadero_24h.csv: perfil SINTETICO de 24 h de un invernadero.
+
+Datos para test_rbe_benchmark (pio test -e native -f test_rbe_benchmark -v),
+que imprime la reduccion de publicaciones con cada configuracion del filtro
+(bandas y heartbeat definidos en test_rbe_benchmark/test_main.c).
+Con los parametros de abajo el fichero es reproducible byte a byte:
+
+    python3 test/data/generar_invernadero.py
+
+Modelo (una muestra cada PERIODO_S, como leeria el DHT22):
+  - Temperatura: primer orden hacia un objetivo que sigue el sol (amanecer
+    6:30, 13 h de luz) con nubes; la ventilacion se abre entre 11 y 16 h si
+    se superan VENT_UMBRAL_C y baja el objetivo VENT_DESCENSO_C
+  - Humedad: primer orden hacia un objetivo que baja con la temperatura;
+    cada riego (RIEGOS_H) la sube RIEGO_PCT y se disipa exponencialmente
+  - Ruido gaussiano del proceso y del sensor, redondeo a 0.1 como el DHT22
+"""
+import math
+import os
+import random
+import sys
+
+SEMILLA = 2026
+PERIODO_S = 30
+MUESTRAS = 2880  # 24 h
+
+T_INICIAL_C = 22.0
+T_NOCHE_C = 16.5
+T_AMPLITUD_C = 11.0
+T_CONSTANTE = 0.04  # Fraccion del error corregida por muestra
+T_RUIDO_PROCESO = 0.03
+VENT_UMBRAL_C = 26.5
+VENT_DESCENSO_C = 3.0
+VENT_CIERRE = 0.02  # Cierre de la ventilacion por muestra
+
+H_INICIAL_PCT = 80.0
+H_BASE_PCT = 88.0
+H_POR_GRADO = 2.6  # Humedad que baja por cada grado sobre H_T_REF_C
+H_T_REF_C = 16.0
+H_CONSTANTE = 0.05
+H_RUIDO_PROCESO = 0.08
+RIEGOS_H = (7.0, 13.0, 18.5)
+RIEGO_PCT = 9.0
+RIEGO_DISIPACION = 0.985
+
+RUIDO_SENSOR_T = 0.05
+RUIDO_SENSOR_H = 0.1
+
+CABECERA = """\
+# Perfil SINTETICO de 24 h de un invernadero (no es una grabacion de campo):
+# ciclo diurno de temperatura, ventilacion a mediodia, tres riegos que suben
+# la humedad, ruido tipo DHT22 y resolucion de 0.1 como entrega el sensor.
+# Generado con generar_invernadero.py (semilla 2026, parametros en el script).
+# Sustituir por un export real con las mismas columnas cuando exista.
+timestamp_s,temperature_c,humidity_pct
+"""
+
+
+def generar():
+    random.seed(SEMILLA)
+    temp, hum = T_INICIAL_C, H_INICIAL_PCT
+    riego = vent = 0.0
+    filas = []
+    for i in range(MUESTRAS):
+        t = i * PERIODO_S
+        hora = t / 3600.0
+        sol = max(0.0, math.sin(math.pi * (hora - 6.5) / 13.0))
+        nube = 0.15 * math.sin(2 * math.pi * hora / 1.7) * sol
+        objetivo = T_NOCHE_C + T_AMPLITUD_C * (sol + nube)
+        if 11 <= hora < 16 and temp > VENT_UMBRAL_C:
+            vent = 1.0
+        if vent > 0:
+            objetivo -= VENT_DESCENSO_C * vent
+            vent = max(0.0, vent - VENT_CIERRE)
+        temp += (objetivo - temp) * T_CONSTANTE + random.gauss(
+            0, T_RUIDO_PROCESO)
+
+        if any(abs(hora - r) < 0.01 for r in RIEGOS_H):
+            riego = RIEGO_PCT
+        h_objetivo = H_BASE_PCT - H_POR_GRADO * (temp - H_T_REF_C) + riego
+        riego *= RIEGO_DISIPACION
+        hum += (h_objetivo - hum) * H_CONSTANTE + random.gauss(
+            0, H_RUIDO_PROCESO)
+        hum = min(99.9, max(20.0, hum))
+
+        filas.append((t, round(temp + random.gauss(0, RUIDO_SENSOR_T), 1),
+                      round(hum + random.gauss(0, RUIDO_SENSOR_H), 1)))
+    return filas
+
+
+def main():
+    destino = sys.argv[1] if len(sys.argv) > 1 else os.path.join(
+        os.path.dirname(os.path.abspath(__file__)), "invernadero_24h.csv")
+    with open(destino, "w") as f:
+        f.write(CABECERA)
+        for fila in generar():
+            f.write("%d,%.1f,%.1f\n" % fila)
+
+
+if __name__ == "__main__":
+    main()
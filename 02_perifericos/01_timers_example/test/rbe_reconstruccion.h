@@ -0,0 +1,54 @@
+// Utilidades comunes de los tests del filtro report by exception: pasar una
+// serie por el filtro y medir el error al reconstruirla. Los tests unitarios
+// y el benchmark comprueban la cota de error con el mismo codigo
+#pragma once
+
+#include "report_by_exception.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Pasa toda la serie por el filtro (incluido el flush final). Escribe los
+// puntos emitidos en emitidos (hasta n * RBE_MAX_OUT) y devuelve cuantos son
+static int rbe_filtrar_serie(const rbe_channel_cfg_t *cfg,
+                             const float *valores, const uint64_t *tiempos,
+                             int n, rbe_channel_t *ch,
+                             rbe_point_t *emitidos) {
+  rbe_point_t out[RBE_MAX_OUT];
+  int num_emitidos = 0;
+  rbe_channel_init(ch, cfg);
+  for (int i = 0; i < n; i++) {
+    int k = rbe_process(ch, valores[i], tiempos[i], out);
+    for (int j = 0; j < k; j++) {
+      emitidos[num_emitidos++] = out[j];
+    }
+  }
+  if (rbe_flush(ch, &out[0])) {
+    emitidos[num_emitidos++] = out[0];
+  }
+  return num_emitidos;
+}
+
+// Error maximo al reconstruir la serie a partir de los puntos emitidos:
+// interpolacion lineal (swinging door) o mantener el ultimo (banda muerta)
+static float rbe_error_reconstruccion(const float *valores,
+                                      const uint64_t *tiempos, int n,
+                                      const rbe_point_t *emitidos,
+                                      int num_emitidos, bool interpolar) {
+  float max_err = 0.0f;
+  int j = 0;
+  for (int i = 0; i < n; i++) {
+    while (j + 1 < num_emitidos && emitidos[j + 1].timestamp <= tiempos[i]) {
+      j++;
+    }
+    float r = emitidos[j].value;
+    if (interpolar && j + 1 < num_emitidos) {
+      float f = (float)(tiempos[i] - emitidos[j].timestamp) /
+                (float)(emitidos[j + 1].timestamp - emitidos[j].timestamp);
+      r += f * (emitidos[j + 1].value - emitidos[j].value);
+    }
+    float err = fabsf(r - valores[i]);
+    max_err = err > max_err ? err : max_err;
+  }
+  return max_err;
+}
@@ -0,0 +1,116 @@
+// Benchmark en el PC: reduccion de publicaciones sobre datos de invernadero
+// (pio test -e native -f test_rbe_benchmark -v para ver la tabla)
+#include "../rbe_reconstruccion.h"
+#include "report_by_exception.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include <unity.h>
+
+#ifndef RBE_DATA_CSV
+#define RBE_DATA_CSV "test/data/invernadero_24h.csv"
+#endif
+
+#define MAX_MUESTRAS 4096
+#define REPETICIONES 200 // Pasadas para medir el tiempo por lectura
+#define EPS 1e-4f
+
+static uint64_t tiempos[MAX_MUESTRAS];
+static float temperatura[MAX_MUESTRAS];
+static float humedad[MAX_MUESTRAS];
+static int num_muestras;
+
+static rbe_point_t emitidos[MAX_MUESTRAS * RBE_MAX_OUT];
+static int num_emitidos;
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+static void cargar_csv(void) {
+  FILE *f = fopen(RBE_DATA_CSV, "r");
+  TEST_ASSERT_NOT_NULL(f);
+  char linea[128];
+  num_muestras = 0;
+  while (fgets(linea, sizeof(linea), f) && num_muestras < MAX_MUESTRAS) {
+    unsigned long long ts;
+    float t, h;
+    if (linea[0] == '#' || sscanf(linea, "%llu,%f,%f", &ts, &t, &h) != 3) {
+      continue; // Comentarios y cabecera
+    }
+    tiempos[num_muestras] = ts * 1000000ULL;
+    temperatura[num_muestras] = t;
+    humedad[num_muestras] = h;
+    num_muestras++;
+  }
+  fclose(f);
+  TEST_ASSERT_TRUE(num_muestras > 1000);
+}
+
+// Ejecuta un caso, comprueba la cota de error e imprime una fila
+static void caso(const char *nombre, const rbe_channel_cfg_t *cfg,
+                 const float *valores, float cota) {
+  rbe_channel_t ch;
+  clock_t inicio = clock();
+  for (int r = 0; r < REPETICIONES; r++) {
+    num_emitidos = rbe_filtrar_serie(cfg, valores, tiempos, num_muestras,
+                                     &ch, emitidos);
+  }
+  double ns = (double)(clock() - inicio) / CLOCKS_PER_SEC * 1e9 /
+              ((double)REPETICIONES * num_muestras);
+
+  float err = rbe_error_reconstruccion(valores, tiempos, num_muestras,
+                                       emitidos, num_emitidos,
+                                       cfg->swinging_door);
+  char fila[160];
+  snprintf(fila, sizeof(fila),
+           "%-28s %5d -> %4d puntos  reduccion %5.1fx  error max %.3f "
+           "(cota %.3f)  %.0f ns/lectura",
+           nombre, num_muestras, num_emitidos, rbe_reduction_ratio(&ch), err,
+           cota, ns);
+  TEST_MESSAGE(fila);
+  TEST_ASSERT_TRUE(err <= cota + EPS);
+  TEST_ASSERT_TRUE(rbe_reduction_ratio(&ch) > 1.0f);
+}
+
+// Banda porcentual: la cota se toma sobre el mayor valor de la serie
+static float cota_porcentual(const float *valores, float pct) {
+  float max_abs = 0.0f;
+  for (int i = 0; i < num_muestras; i++) {
+    max_abs = fabsf(valores[i]) > max_abs ? fabsf(valores[i]) : max_abs;
+  }
+  return pct * max_abs / 100.0f;
+}
+
+void test_benchmark_temperature(void) {
+  cargar_csv();
+  const uint64_t latido = 10ULL * 60 * 1000000;
+  rbe_channel_cfg_t banda = {.abs_deadband = 0.3f};
+  rbe_channel_cfg_t banda_hb = {.abs_deadband = 0.3f,
+                                .max_silence_us = latido};
+  rbe_channel_cfg_t sdt = {.abs_deadband = 0.3f, .swinging_door = true};
+  rbe_channel_cfg_t sdt_hb = {.abs_deadband = 0.3f,
+                              .max_silence_us = latido,
+                              .swinging_door = true};
+  caso("temp banda 0.3C", &banda, temperatura, 0.3f);
+  caso("temp banda 0.3C + 10min", &banda_hb, temperatura, 0.3f);
+  caso("temp swinging door 0.3C", &sdt, temperatura, 0.3f);
+  caso("temp swinging door + 10min", &sdt_hb, temperatura, 0.3f);
+}
+
+void test_benchmark_humidity(void) {
+  cargar_csv();
+  rbe_channel_cfg_t banda = {.pct_deadband = 2.0f};
+  rbe_channel_cfg_t sdt = {.pct_deadband = 2.0f, .swinging_door = true};
+  float cota = cota_porcentual(humedad, 2.0f);
+  caso("hum banda 2%", &banda, humedad, cota);
+  caso("hum swinging door 2%", &sdt, humedad, cota);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_benchmark_temperature);
+  RUN_TEST(test_benchmark_humidity);
+  return UNITY_END();
+}
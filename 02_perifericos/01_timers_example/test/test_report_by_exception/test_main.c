@@ -0,0 +1,229 @@
+// Tests en el PC del filtro report by exception (pio test -e native)
+#include "../rbe_reconstruccion.h"
+#include "report_by_exception.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unity.h>
+
+#define SERIE_N 5000
+#define PERIODO_US 2000000ULL // Una lectura cada 2 s, como el timer
+#define EPS 1e-4f             // Margen por redondeo de float
+
+static float valores[SERIE_N];
+static uint64_t tiempos[SERIE_N];
+static rbe_point_t emitidos[SERIE_N * RBE_MAX_OUT];
+static int num_emitidos;
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+// Paseo aleatorio con deriva lenta, parecido a una temperatura real
+static void generar_serie(unsigned semilla) {
+  srand(semilla);
+  float x = 25.0f;
+  for (int i = 0; i < SERIE_N; i++) {
+    x += ((rand() % 1000) / 1000.0f - 0.5f) * 0.1f + 0.02f * sinf(i / 300.0f);
+    valores[i] = x;
+    tiempos[i] = (uint64_t)i * PERIODO_US;
+  }
+}
+
+static void filtrar_serie(const rbe_channel_cfg_t *cfg, rbe_channel_t *ch) {
+  num_emitidos =
+      rbe_filtrar_serie(cfg, valores, tiempos, SERIE_N, ch, emitidos);
+}
+
+static float error_reconstruccion(bool interpolar) {
+  return rbe_error_reconstruccion(valores, tiempos, SERIE_N, emitidos,
+                                  num_emitidos, interpolar);
+}
+
+static void comprobar_orden_cronologico(void) {
+  for (int i = 1; i < num_emitidos; i++) {
+    TEST_ASSERT_TRUE(emitidos[i].timestamp > emitidos[i - 1].timestamp);
+  }
+}
+
+void test_first_point_always_reported(void) {
+  rbe_channel_cfg_t cfg = {.abs_deadband = 1.0f, .swinging_door = true};
+  rbe_channel_t ch;
+  rbe_channel_init(&ch, &cfg);
+  rbe_point_t out[RBE_MAX_OUT];
+  TEST_ASSERT_EQUAL_INT(1, rbe_process(&ch, 21.5f, 10, out));
+  TEST_ASSERT_FLOAT_WITHIN(0.0f, 21.5f, out[0].value);
+  TEST_ASSERT_EQUAL_UINT64(10, out[0].timestamp);
+}
+
+void test_deadband_absolute_threshold(void) {
+  rbe_channel_cfg_t cfg = {.abs_deadband = 0.5f};
+  rbe_channel_t ch;
+  rbe_channel_init(&ch, &cfg);
+  rbe_point_t out[RBE_MAX_OUT];
+  rbe_process(&ch, 20.0f, 1, out);
+  TEST_ASSERT_EQUAL_INT(0, rbe_process(&ch, 20.4f, 2, out));
+  TEST_ASSERT_EQUAL_INT(0, rbe_process(&ch, 19.6f, 3, out));
+  TEST_ASSERT_EQUAL_INT(1, rbe_process(&ch, 20.6f, 4, out));
+  TEST_ASSERT_FLOAT_WITHIN(0.0f, 20.6f, out[0].value);
+  // La referencia pasa a ser el ultimo valor reportado
+  TEST_ASSERT_EQUAL_INT(0, rbe_process(&ch, 20.2f, 5, out));
+}
+
+void test_deadband_percent_and_largest_band_wins(void) {
+  rbe_channel_cfg_t cfg = {.pct_deadband = 2.0f}; // 2% de 50 = 1.0
+  rbe_channel_t ch;
+  rbe_channel_init(&ch, &cfg);
+  rbe_point_t out[RBE_MAX_OUT];
+  rbe_process(&ch, 50.0f, 1, out);
+  TEST_ASSERT_EQUAL_INT(0, rbe_process(&ch, 50.9f, 2, out));
+  TEST_ASSERT_EQUAL_INT(1, rbe_process(&ch, 51.1f, 3, out));
+
+  cfg.abs_deadband = 1.5f; // Mayor que el 2%: manda la absoluta
+  rbe_channel_init(&ch, &cfg);
+  rbe_process(&ch, 50.0f, 1, out);
+  TEST_ASSERT_EQUAL_INT(0, rbe_process(&ch, 51.1f, 2, out));
+  TEST_ASSERT_EQUAL_INT(1, rbe_process(&ch, 51.6f, 3, out));
+}
+
+void test_deadband_hold_last_error_bound(void) {
+  rbe_channel_cfg_t cfg = {.abs_deadband = 0.3f};
+  rbe_channel_t ch;
+  generar_serie(3);
+  filtrar_serie(&cfg, &ch);
+  comprobar_orden_cronologico();
+  TEST_ASSERT_TRUE(error_reconstruccion(false) <= cfg.abs_deadband + EPS);
+  TEST_ASSERT_TRUE(rbe_reduction_ratio(&ch) > 2.0f);
+}
+
+void test_deadband_heartbeat(void) {
+  rbe_channel_cfg_t cfg = {.abs_deadband = 1.0f, .max_silence_us = 10};
+  rbe_channel_t ch;
+  rbe_channel_init(&ch, &cfg);
+  rbe_point_t out[RBE_MAX_OUT];
+  rbe_process(&ch, 5.0f, 0, out);
+  for (uint64_t t = 1; t < 10; t++) {
+    TEST_ASSERT_EQUAL_INT(0, rbe_process(&ch, 5.0f, t, out));
+  }
+  TEST_ASSERT_EQUAL_INT(1, rbe_process(&ch, 5.0f, 10, out));
+  TEST_ASSERT_EQUAL_UINT64(10, out[0].timestamp);
+  TEST_ASSERT_EQUAL_INT(0, rbe_process(&ch, 5.0f, 11, out));
+}
+
+void test_swinging_door_interpolation_error_bound(void) {
+  const float bandas[] = {0.05f, 0.3f, 1.0f};
+  for (int b = 0; b < 3; b++) {
+    rbe_channel_cfg_t cfg = {.abs_deadband = bandas[b],
+                             .swinging_door = true};
+    rbe_channel_t ch;
+    generar_serie(10 + b);
+    filtrar_serie(&cfg, &ch);
+    comprobar_orden_cronologico();
+    TEST_ASSERT_TRUE(error_reconstruccion(true) <= bandas[b] + EPS);
+    TEST_ASSERT_EQUAL_UINT32(SERIE_N, ch.received);
+    TEST_ASSERT_EQUAL_UINT32(num_emitidos, ch.emitted);
+  }
+}
+
+void test_swinging_door_with_heartbeat_error_bound(void) {
+  rbe_channel_cfg_t cfg = {.abs_deadband = 0.3f,
+                           .max_silence_us = 60 * PERIODO_US,
+                           .swinging_door = true};
+  rbe_channel_t ch;
+  generar_serie(21);
+  filtrar_serie(&cfg, &ch);
+  comprobar_orden_cronologico();
+  TEST_ASSERT_TRUE(error_reconstruccion(true) <= cfg.abs_deadband + EPS);
+  for (int i = 1; i < num_emitidos; i++) {
+    TEST_ASSERT_TRUE(emitidos[i].timestamp - emitidos[i - 1].timestamp <=
+                     cfg.max_silence_us);
+  }
+}
+
+void test_swinging_door_ramp_keeps_single_segment(void) {
+  // Una rampa perfecta cabe en el corredor: solo extremos y heartbeat
+  rbe_channel_cfg_t cfg = {.abs_deadband = 0.1f,
+                           .max_silence_us = 100,
+                           .swinging_door = true};
+  rbe_channel_t ch;
+  rbe_channel_init(&ch, &cfg);
+  rbe_point_t out[RBE_MAX_OUT];
+  rbe_process(&ch, 0.0f, 0, out);
+  for (uint64_t t = 1; t < 100; t++) {
+    TEST_ASSERT_EQUAL_INT(0, rbe_process(&ch, 0.5f * t, t, out));
+  }
+  // Heartbeat con la recta dentro del corredor: un solo punto, el actual
+  TEST_ASSERT_EQUAL_INT(1, rbe_process(&ch, 50.0f, 100, out));
+  TEST_ASSERT_EQUAL_UINT64(100, out[0].timestamp);
+  TEST_ASSERT_FALSE(rbe_flush(&ch, &out[0]));
+}
+
+void test_swinging_door_two_point_emission(void) {
+  // Salto fuera del corredor con el heartbeat vencido: se emite el punto
+  // retenido y tambien el actual, en orden
+  rbe_channel_cfg_t cfg = {.abs_deadband = 0.5f,
+                           .max_silence_us = 3,
+                           .swinging_door = true};
+  rbe_channel_t ch;
+  rbe_channel_init(&ch, &cfg);
+  rbe_point_t out[RBE_MAX_OUT];
+  rbe_process(&ch, 0.0f, 0, out);
+  TEST_ASSERT_EQUAL_INT(0, rbe_process(&ch, 0.0f, 1, out));
+  TEST_ASSERT_EQUAL_INT(2, rbe_process(&ch, 10.0f, 5, out));
+  TEST_ASSERT_EQUAL_UINT64(1, out[0].timestamp);
+  TEST_ASSERT_FLOAT_WITHIN(0.0f, 0.0f, out[0].value);
+  TEST_ASSERT_EQUAL_UINT64(5, out[1].timestamp);
+  TEST_ASSERT_FLOAT_WITHIN(0.0f, 10.0f, out[1].value);
+  TEST_ASSERT_EQUAL_UINT32(3, ch.emitted);
+}
+
+void test_swinging_door_flush_emits_held_point(void) {
+  rbe_channel_cfg_t cfg = {.abs_deadband = 1.0f, .swinging_door = true};
+  rbe_channel_t ch;
+  rbe_channel_init(&ch, &cfg);
+  rbe_point_t out[RBE_MAX_OUT];
+  rbe_process(&ch, 1.0f, 0, out);
+  rbe_process(&ch, 1.2f, 1, out);
+  TEST_ASSERT_TRUE(rbe_flush(&ch, &out[0]));
+  TEST_ASSERT_EQUAL_UINT64(1, out[0].timestamp);
+  TEST_ASSERT_FALSE(rbe_flush(&ch, &out[0]));
+}
+
+void test_non_increasing_timestamp_discarded(void) {
+  rbe_channel_cfg_t cfg = {.abs_deadband = 0.1f};
+  rbe_channel_t ch;
+  rbe_channel_init(&ch, &cfg);
+  rbe_point_t out[RBE_MAX_OUT];
+  rbe_process(&ch, 1.0f, 100, out);
+  TEST_ASSERT_EQUAL_INT(0, rbe_process(&ch, 9.0f, 100, out));
+  TEST_ASSERT_EQUAL_INT(0, rbe_process(&ch, 9.0f, 50, out));
+  TEST_ASSERT_EQUAL_INT(1, rbe_process(&ch, 9.0f, 101, out));
+  // Las descartadas no cuentan para la reduccion
+  TEST_ASSERT_EQUAL_UINT32(2, ch.received);
+  TEST_ASSERT_EQUAL_UINT32(2, ch.discarded);
+  TEST_ASSERT_FLOAT_WITHIN(0.0f, 1.0f, rbe_reduction_ratio(&ch));
+
+  cfg.swinging_door = true;
+  rbe_channel_init(&ch, &cfg);
+  rbe_process(&ch, 1.0f, 100, out);
+  rbe_process(&ch, 1.0f, 200, out); // Retenido
+  TEST_ASSERT_EQUAL_INT(0, rbe_process(&ch, 1.0f, 150, out));
+  TEST_ASSERT_EQUAL_UINT32(2, ch.received);
+  TEST_ASSERT_EQUAL_UINT32(1, ch.discarded);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_first_point_always_reported);
+  RUN_TEST(test_deadband_absolute_threshold);
+  RUN_TEST(test_deadband_percent_and_largest_band_wins);
+  RUN_TEST(test_deadband_hold_last_error_bound);
+  RUN_TEST(test_deadband_heartbeat);
+  RUN_TEST(test_swinging_door_interpolation_error_bound);
+  RUN_TEST(test_swinging_door_with_heartbeat_error_bound);
+  RUN_TEST(test_swinging_door_ramp_keeps_single_segment);
+  RUN_TEST(test_swinging_door_two_point_emission);
+  RUN_TEST(test_swinging_door_flush_emits_held_point);
+  RUN_TEST(test_non_increasing_timestamp_discarded);
+  return UNITY_END();
+}
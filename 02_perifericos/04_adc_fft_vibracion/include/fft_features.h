@@ -0,0 +1,68 @@
+/**
+ * @file fft_features.h
+ * @brief Extraccion de caracteristicas espectrales (vibracion / rizado de
+ * corriente) a partir de una ventana de muestras ADC
+ *
+ * Pipeline por ventana:
+ *   1. Quitar DC y calcular RMS en el dominio del tiempo
+ *   2. Aplicar ventana Hann (tabla precalculada)
+ *   3. FFT real radix-2 (FFT compleja de N/2 puntos + separacion de espectro)
+ *   4. Reducir el espectro a: picos principales, energia por bandas y
+ *      frecuencia de paso de aspas (BPF) del ventilador
+ *
+ * El modulo es C puro (sin dependencias de ESP-IDF) para poder compilarlo y
+ * validarlo tambien en el PC. Usa buffers estaticos: una sola instancia.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define FFT_FEAT_N 1024 // Muestras por ventana (potencia de 2)
+#define FFT_FEAT_PEAKS 3 // Picos reportados por ventana
+#define FFT_FEAT_BANDS 8 // Bandas lineales entre 0 y fs/2
+
+// Configuracion del analisis (fijada en fft_features_init)
+typedef struct {
+  float sample_rate_hz; // Frecuencia de muestreo del ADC
+  float fan_rpm_max;    // RPM del ventilador con duty al 100%
+  uint8_t fan_blades;   // Numero de aspas del ventilador
+  float bpf_tolerance;  // Ventana de busqueda de la BPF (fraccion, ej. 0.15)
+} fft_features_cfg_t;
+
+typedef struct {
+  uint16_t bin;    // Indice del bin (0 = sin pico)
+  float freq_hz;   // Frecuencia interpolada (parabolica)
+  float amplitude; // Amplitud del seno equivalente (cuentas ADC)
+} fft_peak_t;
+
+// Resultado compacto de una ventana: esto es lo que se envia, no las muestras
+typedef struct {
+  float dc;                          // Valor medio (cuentas ADC)
+  float rms;                         // RMS sin DC (cuentas ADC)
+  fft_peak_t peaks[FFT_FEAT_PEAKS];  // Ordenados de mayor a menor
+  float band_power[FFT_FEAT_BANDS];  // Potencia por banda (cuentas^2)
+  float bpf_expected_hz;             // BPF esperada segun el duty comandado
+  float bpf_measured_hz;             // Pico real cerca de la BPF esperada
+  float bpf_amplitude;               // Amplitud del pico de BPF
+} fft_features_t;
+
+/**
+ * Precalcula ventana Hann, twiddles y tabla de bit-reversal.
+ * Debe llamarse una vez antes de cualquier otra funcion.
+ */
+void fft_features_init(const fft_features_cfg_t *cfg);
+
+/**
+ * FFT real in-place de FFT_FEAT_N muestras.
+ * Salida empaquetada: data[0] = X[0], data[1] = X[N/2] (ambos reales) y
+ * data[2k], data[2k+1] = Re/Im de X[k] para 1 <= k < N/2.
+ */
+void fft_real_forward(float *data);
+
+/**
+ * Procesa una ventana completa de FFT_FEAT_N muestras crudas del ADC.
+ * duty_frac es el duty comandado al ventilador (0.0 - 1.0).
+ */
+void fft_features_compute(const uint16_t *samples, float duty_frac,
+                          fft_features_t *out);
@@ -0,0 +1,222 @@
+#include "fft_features.h"
+#include <math.h>
+#include <stddef.h>
+
+#define FFT_HALF (FFT_FEAT_N / 2)
+#define FFT_PI 3.14159265358979323846
+
+// Configuracion y tablas precalculadas (solo se calculan en el init)
+static fft_features_cfg_t cfg_actual;
+static float hann[FFT_FEAT_N];
+static float tw_cos[FFT_HALF]; // W_N^k = tw_cos[k] - i * tw_sin[k]
+static float tw_sin[FFT_HALF];
+static uint16_t bitrev[FFT_HALF];
+static float window_sum;    // Suma de la ventana (ganancia coherente)
+static float window_sum_sq; // Suma de la ventana al cuadrado (potencia)
+
+// Buffers de trabajo: muestras con ventana -> espectro -> potencia por bin
+static float work[FFT_FEAT_N];
+static float power[FFT_HALF];
+
+void fft_features_init(const fft_features_cfg_t *cfg) {
+  cfg_actual = *cfg;
+
+  // Hann periodica: sin fuga de DC y con ENBW = 1.5 bins
+  window_sum = 0.0f;
+  window_sum_sq = 0.0f;
+  for (int n = 0; n < FFT_FEAT_N; n++) {
+    hann[n] = (float)(0.5 - 0.5 * cos(2.0 * FFT_PI * n / FFT_FEAT_N));
+    window_sum += hann[n];
+    window_sum_sq += hann[n] * hann[n];
+  }
+  // Una sola tabla de N/2 twiddles sirve para la FFT compleja de N/2 puntos
+  // (paso 2) y para la separacion del espectro real (paso 1)
+  for (int k = 0; k < FFT_HALF; k++) {
+    tw_cos[k] = (float)cos(2.0 * FFT_PI * k / FFT_FEAT_N);
+    tw_sin[k] = (float)sin(2.0 * FFT_PI * k / FFT_FEAT_N);
+  }
+  int bits = 0;
+  while ((1 << bits) < FFT_HALF) {
+    bits++;
+  }
+  for (int i = 0; i < FFT_HALF; i++) {
+    uint16_t r = 0;
+    for (int b = 0; b < bits; b++) {
+      r = (r << 1) | ((i >> b) & 1);
+    }
+    bitrev[i] = r;
+  }
+}
+
+// FFT compleja radix-2 DIT in-place de N/2 puntos (datos intercalados re/im)
+static void fft_complex_half(float *z) {
+  for (int i = 0; i < FFT_HALF; i++) {
+    int j = bitrev[i];
+    if (j > i) {
+      float tr = z[2 * i];
+      float ti = z[2 * i + 1];
+      z[2 * i] = z[2 * j];
+      z[2 * i + 1] = z[2 * j + 1];
+      z[2 * j] = tr;
+      z[2 * j + 1] = ti;
+    }
+  }
+  for (int size = 2; size <= FFT_HALF; size <<= 1) {
+    int half = size >> 1;
+    int step = FFT_FEAT_N / size; // W_size^j = W_N^(j * N / size)
+    for (int i = 0; i < FFT_HALF; i += size) {
+      for (int j = 0; j < half; j++) {
+        float wr = tw_cos[j * step];
+        float wi = -tw_sin[j * step];
+        float *a = &z[2 * (i + j)];
+        float *b = &z[2 * (i + j + half)];
+        float tr = wr * b[0] - wi * b[1];
+        float ti = wr * b[1] + wi * b[0];
+        b[0] = a[0] - tr;
+        b[1] = a[1] - ti;
+        a[0] += tr;
+        a[1] += ti;
+      }
+    }
+  }
+}
+
+void fft_real_forward(float *data) {
+  // Las N muestras reales se ven como N/2 complejos z[k] = x[2k] + i x[2k+1]
+  fft_complex_half(data);
+
+  // Separar el espectro: X[k] = E[k] + W^k O[k], X[N/2-k] = conj(E - W^k O)
+  float z0r = data[0];
+  float z0i = data[1];
+  data[0] = z0r + z0i; // X[0]
+  data[1] = z0r - z0i; // X[N/2]
+  for (int k = 1; k <= FFT_HALF / 2; k++) {
+    int m = FFT_HALF - k;
+    float zr = data[2 * k];
+    float zi = data[2 * k + 1];
+    float zr2 = data[2 * m];
+    float zi2 = data[2 * m + 1];
+
+    float er = 0.5f * (zr + zr2);
+    float ei = 0.5f * (zi - zi2);
+    float or_ = 0.5f * (zi + zi2);
+    float oi = -0.5f * (zr - zr2);
+
+    float c = tw_cos[k];
+    float s = tw_sin[k];
+    float tr = c * or_ + s * oi;
+    float ti = c * oi - s * or_;
+
+    data[2 * k] = er + tr;
+    data[2 * k + 1] = ei + ti;
+    data[2 * m] = er - tr;
+    data[2 * m + 1] = ti - ei;
+  }
+}
+
+// Interpolacion parabolica sobre la magnitud de los bins vecinos
+static void refine_peak(int k, fft_peak_t *peak) {
+  float bin_hz = cfg_actual.sample_rate_hz / FFT_FEAT_N;
+  float alpha = sqrtf(power[k - 1]);
+  float beta = sqrtf(power[k]);
+  float gamma = sqrtf(power[k + 1]);
+  float denom = alpha - 2.0f * beta + gamma;
+  float delta = denom != 0.0f ? 0.5f * (alpha - gamma) / denom : 0.0f;
+
+  peak->bin = (uint16_t)k;
+  peak->freq_hz = (k + delta) * bin_hz;
+  peak->amplitude = 2.0f * beta / window_sum;
+}
+
+void fft_features_compute(const uint16_t *samples, float duty_frac,
+                          fft_features_t *out) {
+  // 1. DC y RMS en el dominio del tiempo
+  float sum = 0.0f;
+  for (int n = 0; n < FFT_FEAT_N; n++) {
+    sum += samples[n];
+  }
+  float mean = sum / FFT_FEAT_N;
+  float sum_sq = 0.0f;
+  for (int n = 0; n < FFT_FEAT_N; n++) {
+    float x = samples[n] - mean;
+    sum_sq += x * x;
+    work[n] = x * hann[n]; // 2. Ventana
+  }
+  out->dc = mean;
+  out->rms = sqrtf(sum_sq / FFT_FEAT_N);
+
+  // 3. FFT y espectro de potencia (sin raices: solo |X|^2)
+  fft_real_forward(work);
+  power[0] = 0.0f; // DC ya eliminado
+  for (int k = 1; k < FFT_HALF; k++) {
+    power[k] = work[2 * k] * work[2 * k] + work[2 * k + 1] * work[2 * k + 1];
+  }
+
+  // 4a. Potencia por bandas, escalada para que la suma ~ rms^2 (Parseval)
+  const float power_scale = 2.0f / (FFT_FEAT_N * window_sum_sq);
+  const int bins_per_band = FFT_HALF / FFT_FEAT_BANDS;
+  for (int b = 0; b < FFT_FEAT_BANDS; b++) {
+    float acc = 0.0f;
+    for (int k = b * bins_per_band; k < (b + 1) * bins_per_band; k++) {
+      acc += power[k];
+    }
+    out->band_power[b] = acc * power_scale;
+  }
+
+  // 4b. Top-K de maximos locales (insercion ordenada, K pequeno)
+  int top[FFT_FEAT_PEAKS];
+  int found = 0;
+  for (int k = 1; k < FFT_HALF - 1; k++) {
+    float p = power[k];
+    if (p <= 0.0f || p <= power[k - 1] || p < power[k + 1]) {
+      continue;
+    }
+    int pos = found < FFT_FEAT_PEAKS ? found : FFT_FEAT_PEAKS;
+    while (pos > 0 && power[top[pos - 1]] < p) {
+      if (pos < FFT_FEAT_PEAKS) {
+        top[pos] = top[pos - 1];
+      }
+      pos--;
+    }
+    if (pos < FFT_FEAT_PEAKS) {
+      top[pos] = k;
+      if (found < FFT_FEAT_PEAKS) {
+        found++;
+      }
+    }
+  }
+  for (int i = 0; i < FFT_FEAT_PEAKS; i++) {
+    if (i < found) {
+      refine_peak(top[i], &out->peaks[i]);
+    } else {
+      out->peaks[i] = (fft_peak_t){0};
+    }
+  }
+
+  // 4c. Frecuencia de paso de aspas: esperada por duty vs. medida
+  float bin_hz = cfg_actual.sample_rate_hz / FFT_FEAT_N;
+  float expected =
+      duty_frac * cfg_actual.fan_rpm_max / 60.0f * cfg_actual.fan_blades;
+  out->bpf_expected_hz = expected;
+  out->bpf_measured_hz = 0.0f;
+  out->bpf_amplitude = 0.0f;
+  if (expected < 2.0f * bin_hz) {
+    return; // Ventilador parado o BPF por debajo de la resolucion
+  }
+  int k_lo = (int)(expected * (1.0f - cfg_actual.bpf_tolerance) / bin_hz);
+  int k_hi = (int)(expected * (1.0f + cfg_actual.bpf_tolerance) / bin_hz) + 1;
+  k_lo = k_lo < 1 ? 1 : k_lo;
+  k_hi = k_hi > FFT_HALF - 2 ? FFT_HALF - 2 : k_hi;
+  int k_best = 0;
+  for (int k = k_lo; k <= k_hi; k++) {
+    if (k_best == 0 || power[k] > power[k_best]) {
+      k_best = k;
+    }
+  }
+  if (k_best > 0 && power[k_best] > 0.0f) {
+    fft_peak_t bpf;
+    refine_peak(k_best, &bpf);
+    out->bpf_measured_hz = bpf.freq_hz;
+    out->bpf_amplitude = bpf.amplitude;
+  }
+}
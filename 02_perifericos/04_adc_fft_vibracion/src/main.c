@@ -0,0 +1,233 @@
+/**
+ * @file main.c
+ * @brief Monitoreo de vibracion / rizado de corriente con ADC continuo y FFT
+ *
+ * Aplicación real: Mantenimiento predictivo de motores y ventiladores
+ * - ADC1 en modo continuo (DMA) a 20 kHz, sin lecturas sueltas con
+ *   adc1_get_raw (que no pasan de unos pocos kHz y con mucho jitter)
+ * - Ventanas de 1024 muestras (~51 ms, resolucion ~19.5 Hz por bin)
+ * - Ventana Hann + FFT real radix-2 (ver fft_features.c)
+ * - Cada ventana se reduce a caracteristicas compactas: DC, RMS, picos
+ *   principales, energia por bandas y frecuencia de paso de aspas (BPF)
+ * - La BPF medida se compara con la esperada segun el duty PWM comandado al
+ *   ventilador (mismo LEDC que 02_pwm_example, 25 kHz)
+ * - Solo las caracteristicas salen por la cola, nunca las muestras crudas
+ *
+ * Buenas prácticas implementadas:
+ *   - Tarea de adquisicion notificada desde la ISR del ADC (sin polling)
+ *   - Tablas de ventana/twiddles precalculadas una sola vez
+ *   - Kernels DSP validados en el PC contra una DFT de referencia
+ *     (pio test -e native, ver test/test_fft_features)
+ *   - Benchmark de ciclos de CPU por ventana (esp_cpu_get_cycle_count)
+ *
+ * Hardware:
+ *   - Sensor de vibracion (acelerometro analogico) o shunt + amplificador de
+ *     corriente en GPIO32 (ADC1_CHANNEL_4), rango 0-3.3V
+ *   - Ventilador PWM en GPIO13
+ *
+ * Referencia oficial:
+ *   https://docs.espressif.com/projects/esp-idf/en/stable/esp32/api-reference/peripherals/adc_continuous.html
+ */
+#include "esp_adc/adc_continuous.h"
+#include "esp_attr.h"
+#include "esp_cpu.h"
+#include "fft_features.h"
+#include "freertos/projdefs.h"
+#include "hal/adc_types.h"
+#include "hal/ledc_types.h"
+#include <driver/ledc.h>
+#include <esp_err.h>
+#include <esp_log.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#include <stdint.h>
+#include <stdio.h>
+
+static const char *TAG = "VIB_FFT";
+
+// Configuracion del ADC continuo
+#define VIB_ADC_CHANNEL ADC_CHANNEL_4 // GPIO32
+#define VIB_ADC_ATTEN ADC_ATTEN_DB_12
+#define VIB_SAMPLE_RATE_HZ 20000
+#define VIB_READ_LEN 256 // Bytes por lectura del driver (frame DMA)
+#define VIB_STORE_BUF_SIZE 4096
+
+// Ventilador: mismos parametros que 02_pwm_example
+#define FAN_PWM_PIN GPIO_NUM_13
+#define FAN_PWM_CHANNEL LEDC_CHANNEL_0
+#define FAN__PWM_TIMER LEDC_TIMER_0
+#define FAN_PWM_SPEED_MODE LEDC_HIGH_SPEED_MODE
+#define FAN_PWM_FREQ_HZ 25000
+#define FAN_PWM_RESOLUTION LEDC_TIMER_10_BIT
+#define MAX_DUTY ((1 << FAN_PWM_RESOLUTION) - 1)
+#define FAN_RPM_MAX 3000.0f // Dato de la hoja del ventilador
+#define FAN_BLADES 7
+#define FAN_DEMO_DUTY (MAX_DUTY * 6 / 10)
+
+// Benchmark: resumen cada N ventanas
+#define BENCH_WINDOWS 50
+
+// Mensaje que sale hacia la publicacion (MQTT, LoRa, etc.)
+typedef struct {
+  fft_features_t feat;
+  uint32_t cycles; // Ciclos de CPU que costo procesar la ventana
+} vib_msg_t;
+
+static adc_continuous_handle_t adc_handle = NULL;
+static TaskHandle_t adc_task_handle = NULL;
+static QueueHandle_t feature_queue = NULL;
+
+// Buffer de la ventana en curso (muestras crudas, nunca salen de aqui)
+static uint16_t window_buf[FFT_FEAT_N];
+
+// ISR del driver: solo despierta a la tarea de adquisicion
+static bool IRAM_ATTR adc_conv_done_cb(adc_continuous_handle_t handle,
+                                       const adc_continuous_evt_data_t *edata,
+                                       void *user_data) {
+  BaseType_t must_yield = pdFALSE;
+  vTaskNotifyGiveFromISR(adc_task_handle, &must_yield);
+  return (must_yield == pdTRUE);
+}
+
+static esp_err_t vib_adc_init(void) {
+  adc_continuous_handle_cfg_t handle_cfg = {
+      .max_store_buf_size = VIB_STORE_BUF_SIZE,
+      .conv_frame_size = VIB_READ_LEN};
+  ESP_ERROR_CHECK(adc_continuous_new_handle(&handle_cfg, &adc_handle));
+
+  adc_digi_pattern_config_t pattern = {.atten = VIB_ADC_ATTEN,
+                                       .channel = VIB_ADC_CHANNEL,
+                                       .unit = ADC_UNIT_1,
+                                       .bit_width = SOC_ADC_DIGI_MAX_BITWIDTH};
+  adc_continuous_config_t dig_cfg = {.pattern_num = 1,
+                                     .adc_pattern = &pattern,
+                                     .sample_freq_hz = VIB_SAMPLE_RATE_HZ,
+                                     .conv_mode = ADC_CONV_SINGLE_UNIT_1,
+                                     .format = ADC_DIGI_OUTPUT_FORMAT_TYPE1};
+  ESP_ERROR_CHECK(adc_continuous_config(adc_handle, &dig_cfg));
+
+  adc_continuous_evt_cbs_t cbs = {.on_conv_done = adc_conv_done_cb};
+  ESP_ERROR_CHECK(
+      adc_continuous_register_event_callbacks(adc_handle, &cbs, NULL));
+  ESP_LOGI(TAG, "ADC continuo: canal %d, %d Hz, ventana %d muestras",
+           VIB_ADC_CHANNEL, VIB_SAMPLE_RATE_HZ, FFT_FEAT_N);
+  return ESP_OK;
+}
+
+static esp_err_t fan_pwm_init(void) {
+  ledc_timer_config_t ledc_timer = {.speed_mode = FAN_PWM_SPEED_MODE,
+                                    .duty_resolution = FAN_PWM_RESOLUTION,
+                                    .timer_num = FAN__PWM_TIMER,
+                                    .freq_hz = FAN_PWM_FREQ_HZ,
+                                    .clk_cfg = LEDC_AUTO_CLK};
+  ESP_ERROR_CHECK(ledc_timer_config(&ledc_timer));
+  ledc_channel_config_t ledc_channel = {.gpio_num = FAN_PWM_PIN,
+                                        .speed_mode = FAN_PWM_SPEED_MODE,
+                                        .channel = FAN_PWM_CHANNEL,
+                                        .intr_type = LEDC_INTR_DISABLE,
+                                        .timer_sel = FAN__PWM_TIMER,
+                                        .duty = FAN_DEMO_DUTY,
+                                        .hpoint = 0};
+  ESP_ERROR_CHECK(ledc_channel_config(&ledc_channel));
+  return ESP_OK;
+}
+
+// Adquisicion: junta muestras del DMA hasta completar una ventana y la reduce
+static void adc_task(void *arg) {
+  uint8_t frame[VIB_READ_LEN];
+  int filled = 0;
+
+  ESP_ERROR_CHECK(adc_continuous_start(adc_handle));
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    uint32_t ret_num = 0;
+    while (adc_continuous_read(adc_handle, frame, VIB_READ_LEN, &ret_num, 0) ==
+           ESP_OK) {
+      for (uint32_t i = 0; i < ret_num; i += SOC_ADC_DIGI_RESULT_BYTES) {
+        adc_digi_output_data_t *p = (adc_digi_output_data_t *)&frame[i];
+        if (p->type1.channel != VIB_ADC_CHANNEL) {
+          continue;
+        }
+        window_buf[filled++] = p->type1.data;
+        if (filled < FFT_FEAT_N) {
+          continue;
+        }
+        filled = 0;
+
+        float duty = (float)ledc_get_duty(FAN_PWM_SPEED_MODE, FAN_PWM_CHANNEL) /
+                     MAX_DUTY;
+        vib_msg_t msg;
+        uint32_t start = esp_cpu_get_cycle_count();
+        fft_features_compute(window_buf, duty, &msg.feat);
+        msg.cycles = esp_cpu_get_cycle_count() - start;
+
+        if (xQueueSend(feature_queue, &msg, 0) != pdPASS) {
+          ESP_LOGW(TAG, "Cola de caracteristicas llena");
+        }
+      }
+    }
+  }
+}
+
+// Publicacion: solo recibe caracteristicas (en real: mqtt_publish)
+static void publish_task(void *arg) {
+  vib_msg_t msg;
+  uint32_t windows = 0;
+  uint64_t cycles_sum = 0;
+  uint32_t cycles_max = 0;
+  for (;;) {
+    if (xQueueReceive(feature_queue, &msg, portMAX_DELAY) != pdPASS) {
+      continue;
+    }
+    const fft_features_t *f = &msg.feat;
+    ESP_LOGI(TAG,
+             "DC=%.0f RMS=%.1f | picos %.0fHz(%.1f) %.0fHz(%.1f) %.0fHz(%.1f)"
+             " | BPF esp=%.0fHz med=%.0fHz(%.1f)",
+             f->dc, f->rms, f->peaks[0].freq_hz, f->peaks[0].amplitude,
+             f->peaks[1].freq_hz, f->peaks[1].amplitude, f->peaks[2].freq_hz,
+             f->peaks[2].amplitude, f->bpf_expected_hz, f->bpf_measured_hz,
+             f->bpf_amplitude);
+    ESP_LOGD(TAG, "Bandas: %.1f %.1f %.1f %.1f %.1f %.1f %.1f %.1f",
+             f->band_power[0], f->band_power[1], f->band_power[2],
+             f->band_power[3], f->band_power[4], f->band_power[5],
+             f->band_power[6], f->band_power[7]);
+
+    // Benchmark de ciclos por ventana
+    windows++;
+    cycles_sum += msg.cycles;
+    cycles_max = msg.cycles > cycles_max ? msg.cycles : cycles_max;
+    if (windows == BENCH_WINDOWS) {
+      uint32_t avg = (uint32_t)(cycles_sum / windows);
+      ESP_LOGI(TAG,
+               "Benchmark: %lu ciclos/ventana (max %lu) = %lu us @ %d MHz, "
+               "presupuesto %d us",
+               avg, cycles_max, avg / CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ,
+               CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ,
+               (int)(1000000LL * FFT_FEAT_N / VIB_SAMPLE_RATE_HZ));
+      windows = 0;
+      cycles_sum = 0;
+      cycles_max = 0;
+    }
+  }
+}
+
+void app_main() {
+  fft_features_cfg_t cfg = {.sample_rate_hz = VIB_SAMPLE_RATE_HZ,
+                            .fan_rpm_max = FAN_RPM_MAX,
+                            .fan_blades = FAN_BLADES,
+                            .bpf_tolerance = 0.15f};
+  fft_features_init(&cfg);
+
+  ESP_ERROR_CHECK(fan_pwm_init());
+
+  feature_queue = xQueueCreate(10, sizeof(vib_msg_t));
+  if (feature_queue == NULL) {
+    ESP_LOGE(TAG, "Error creando cola");
+    return;
+  }
+  ESP_ERROR_CHECK(vib_adc_init());
+
+  xTaskCreate(publish_task, "publish_task", 4096, NULL, 5, NULL);
+  xTaskCreate(adc_task, "adc_task", 4096, NULL, 10, &adc_task_handle);
+}
@@ -0,0 +1,163 @@
+// Tests en el PC de los kernels DSP (pio test -e native)
+#include "fft_features.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unity.h>
+
+#define PI_D 3.14159265358979323846
+#define FS_HZ 20000.0f
+#define BIN_HZ (FS_HZ / FFT_FEAT_N)
+
+static const fft_features_cfg_t cfg = {.sample_rate_hz = FS_HZ,
+                                       .fan_rpm_max = 3000.0f,
+                                       .fan_blades = 7,
+                                       .bpf_tolerance = 0.15f};
+
+static float data[FFT_FEAT_N];
+static uint16_t samples[FFT_FEAT_N];
+
+void setUp(void) { fft_features_init(&cfg); }
+
+void tearDown(void) {}
+
+// DFT directa en doble precision: referencia para un bin
+static void dft_bin(const float *x, int k, double *re, double *im) {
+  *re = 0.0;
+  *im = 0.0;
+  for (int n = 0; n < FFT_FEAT_N; n++) {
+    double ang = 2.0 * PI_D * (double)((int64_t)k * n % FFT_FEAT_N) /
+                 FFT_FEAT_N;
+    *re += x[n] * cos(ang);
+    *im -= x[n] * sin(ang);
+  }
+}
+
+// Bin k de la salida empaquetada de fft_real_forward
+static void packed_bin(const float *y, int k, double *re, double *im) {
+  if (k == 0) {
+    *re = y[0];
+    *im = 0.0;
+  } else if (k == FFT_FEAT_N / 2) {
+    *re = y[1];
+    *im = 0.0;
+  } else {
+    *re = y[2 * k];
+    *im = y[2 * k + 1];
+  }
+}
+
+// Genera dos tonos + DC + ruido como muestras ADC de 12 bits
+static void make_samples(float f1, float a1, float f2, float a2) {
+  srand(7);
+  for (int n = 0; n < FFT_FEAT_N; n++) {
+    double t = n / (double)FS_HZ;
+    double v = 2048.0 + a1 * sin(2.0 * PI_D * f1 * t) +
+               a2 * sin(2.0 * PI_D * f2 * t) + (rand() % 5 - 2);
+    samples[n] = (uint16_t)lround(v);
+  }
+}
+
+void test_fft_real_forward_matches_dft(void) {
+  static float x[FFT_FEAT_N];
+  srand(1);
+  for (int n = 0; n < FFT_FEAT_N; n++) {
+    x[n] = (float)(rand() % 4096) - 2048.0f + 300.0f; // con DC
+    data[n] = x[n];
+  }
+  fft_real_forward(data);
+
+  double max_err = 0.0;
+  double max_mag = 0.0;
+  for (int k = 0; k <= FFT_FEAT_N / 2; k++) { // incluye X[0] y X[N/2]
+    double rr, ri, fr, fi;
+    dft_bin(x, k, &rr, &ri);
+    packed_bin(data, k, &fr, &fi);
+    double err = hypot(rr - fr, ri - fi);
+    double mag = hypot(rr, ri);
+    max_err = err > max_err ? err : max_err;
+    max_mag = mag > max_mag ? mag : max_mag;
+  }
+  TEST_ASSERT_TRUE_MESSAGE(max_err / max_mag < 1e-5,
+                           "FFT difiere de la DFT de referencia");
+}
+
+void test_fft_real_forward_dc_and_nyquist(void) {
+  for (int n = 0; n < FFT_FEAT_N; n++) {
+    data[n] = 3.0f + ((n & 1) ? -1.0f : 1.0f); // DC 3 + tono en fs/2
+  }
+  fft_real_forward(data);
+  TEST_ASSERT_FLOAT_WITHIN(1e-2f, 3.0f * FFT_FEAT_N, data[0]);
+  TEST_ASSERT_FLOAT_WITHIN(1e-2f, 1.0f * FFT_FEAT_N, data[1]);
+  for (int k = 1; k < FFT_FEAT_N / 2; k++) {
+    TEST_ASSERT_FLOAT_WITHIN(1e-2f, 0.0f, hypotf(data[2 * k], data[2 * k + 1]));
+  }
+}
+
+void test_features_rms_dc_and_parseval(void) {
+  make_samples(350.0f, 300.0f, 2000.0f, 100.0f);
+  fft_features_t f;
+  fft_features_compute(samples, 0.0f, &f);
+
+  double mean = 0.0;
+  for (int n = 0; n < FFT_FEAT_N; n++) {
+    mean += samples[n];
+  }
+  mean /= FFT_FEAT_N;
+  double var = 0.0;
+  for (int n = 0; n < FFT_FEAT_N; n++) {
+    var += (samples[n] - mean) * (samples[n] - mean);
+  }
+  double rms = sqrt(var / FFT_FEAT_N);
+
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, mean, f.dc);
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, rms, f.rms);
+
+  // La suma de bandas reproduce la varianza (Parseval, ventana corregida)
+  float band_sum = 0.0f;
+  for (int b = 0; b < FFT_FEAT_BANDS; b++) {
+    band_sum += f.band_power[b];
+  }
+  TEST_ASSERT_FLOAT_WITHIN(0.02f * f.rms * f.rms, f.rms * f.rms, band_sum);
+  // 350 Hz y 2000 Hz caen en la primera banda (0-1250 Hz) y la segunda
+  TEST_ASSERT_TRUE(f.band_power[0] > 0.8f * 300.0f * 300.0f / 2);
+  TEST_ASSERT_TRUE(f.band_power[1] > 0.8f * 100.0f * 100.0f / 2);
+}
+
+void test_features_peaks(void) {
+  make_samples(350.0f, 300.0f, 2000.0f, 100.0f);
+  fft_features_t f;
+  fft_features_compute(samples, 0.0f, &f);
+
+  TEST_ASSERT_FLOAT_WITHIN(BIN_HZ / 4, 350.0f, f.peaks[0].freq_hz);
+  TEST_ASSERT_FLOAT_WITHIN(BIN_HZ / 4, 2000.0f, f.peaks[1].freq_hz);
+  // Perdida por scalloping de Hann: como mucho ~15%
+  TEST_ASSERT_FLOAT_WITHIN(0.15f * 300.0f, 300.0f, f.peaks[0].amplitude);
+  TEST_ASSERT_FLOAT_WITHIN(0.15f * 100.0f, 100.0f, f.peaks[1].amplitude);
+  TEST_ASSERT_TRUE(f.peaks[2].amplitude < 5.0f); // Solo ruido
+}
+
+void test_features_blade_pass_frequency(void) {
+  // 3000 RPM * 7 aspas / 60 = 350 Hz con duty 100%
+  make_samples(0.5f * 350.0f, 200.0f, 2000.0f, 100.0f);
+  fft_features_t f;
+  fft_features_compute(samples, 0.5f, &f);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3f, 175.0f, f.bpf_expected_hz);
+  TEST_ASSERT_FLOAT_WITHIN(BIN_HZ / 4, 175.0f, f.bpf_measured_hz);
+  TEST_ASSERT_FLOAT_WITHIN(0.15f * 200.0f, 200.0f, f.bpf_amplitude);
+
+  // Ventilador parado: sin BPF
+  fft_features_compute(samples, 0.0f, &f);
+  TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.0f, f.bpf_expected_hz);
+  TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.0f, f.bpf_measured_hz);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_fft_real_forward_matches_dft);
+  RUN_TEST(test_fft_real_forward_dc_and_nyquist);
+  RUN_TEST(test_features_rms_dc_and_parseval);
+  RUN_TEST(test_features_peaks);
+  RUN_TEST(test_features_blade_pass_frequency);
+  return UNITY_END();
+}
@@ -0,0 +1,83 @@
+/**
+ * @file freq_meter.h
+ * @brief Frecuencimetro reciproco a partir de timestamps de flanco
+ *
+ * La ISR de captura (MCPWM) solo guarda el timestamp de hardware de cada
+ * flanco en un buffer circular por canal: nada de colas ni floats en la ISR.
+ * Una tarea calcula despues la frecuencia reciproca promediando N periodos:
+ *
+ *     f = N * resolucion_hz / (t_ultimo - t_(ultimo - N))
+ *
+ * La precision no depende de la frecuencia de entrada (a diferencia de contar
+ * flancos en una ventana fija) y la resta en uint32_t soporta un desborde
+ * del contador de captura. Con el timer de captura a 80 MHz el contador da
+ * la vuelta cada ~53 s, por eso el timeout debe ser bastante menor.
+ *
+ * C puro (de ESP-IDF solo esp_attr.h): el calculo se puede validar en el PC.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#ifdef ESP_PLATFORM
+#include "esp_attr.h"
+#else
+#define FORCE_INLINE_ATTR static inline __attribute__((always_inline))
+#endif
+
+#define FREQ_METER_RING 32 // Timestamps por canal (potencia de 2)
+#define FREQ_METER_MAX_AVG (FREQ_METER_RING - 1)
+
+typedef enum {
+  FREQ_METER_OK = 0,
+  FREQ_METER_NO_DATA, // Aun no hay dos flancos validos
+  FREQ_METER_TIMEOUT, // Sin flancos durante el timeout: frecuencia cero
+} freq_meter_status_t;
+
+// Estado escrito por la ISR
+typedef struct {
+  volatile uint32_t edges;      // Flancos totales recibidos
+  uint32_t ts[FREQ_METER_RING]; // Timestamps en ticks del timer de captura
+} freq_meter_chan_t;
+
+// Estado del lado de la tarea (uno por canal)
+typedef struct {
+  uint16_t avg_periods;   // Periodos a promediar (1..FREQ_METER_MAX_AVG)
+  uint64_t timeout_us;    // Sin flancos durante este tiempo -> TIMEOUT
+  uint32_t seen_edges;    // Flancos vistos en la ultima lectura
+  uint32_t base_edges;    // Primer flanco valido (tras un timeout)
+  uint64_t last_change_us;
+} freq_meter_reader_t;
+
+typedef struct {
+  freq_meter_status_t status;
+  float freq_hz;    // 0 si no hay medida
+  float period_us;  // 0 si no hay medida
+  uint16_t periods; // Periodos realmente promediados
+} freq_meter_result_t;
+
+// Registra un flanco. Pensada para la ISR en IRAM: inline forzado (con
+// optimizacion de depuracion un static inline puede acabar en flash) y sin
+// llamadas externas.
+FORCE_INLINE_ATTR void freq_meter_push_edge(freq_meter_chan_t *ch,
+                                            uint32_t ticks) {
+  uint32_t n = ch->edges;
+  ch->ts[n & (FREQ_METER_RING - 1)] = ticks;
+  ch->edges = n + 1;
+}
+
+void freq_meter_chan_init(freq_meter_chan_t *ch);
+
+void freq_meter_reader_init(freq_meter_reader_t *rd, uint16_t avg_periods,
+                            uint64_t timeout_us, uint64_t now_us);
+
+/**
+ * Calcula la frecuencia a partir de una copia consistente del canal (tomada
+ * con las interrupciones protegidas). now_us es el tiempo actual de la tarea
+ * (esp_timer_get_time) y resolution_hz la del timer de captura.
+ */
+freq_meter_status_t freq_meter_compute(const freq_meter_chan_t *snap,
+                                       freq_meter_reader_t *rd,
+                                       uint64_t now_us,
+                                       uint32_t resolution_hz,
+                                       freq_meter_result_t *res);
@@ -0,0 +1,63 @@
+#include "freq_meter.h"
+#include <string.h>
+
+void freq_meter_chan_init(freq_meter_chan_t *ch) {
+  memset(ch, 0, sizeof(*ch));
+}
+
+void freq_meter_reader_init(freq_meter_reader_t *rd, uint16_t avg_periods,
+                            uint64_t timeout_us, uint64_t now_us) {
+  memset(rd, 0, sizeof(*rd));
+  if (avg_periods < 1) {
+    avg_periods = 1;
+  } else if (avg_periods > FREQ_METER_MAX_AVG) {
+    avg_periods = FREQ_METER_MAX_AVG;
+  }
+  rd->avg_periods = avg_periods;
+  rd->timeout_us = timeout_us;
+  rd->last_change_us = now_us;
+}
+
+freq_meter_status_t freq_meter_compute(const freq_meter_chan_t *snap,
+                                       freq_meter_reader_t *rd,
+                                       uint64_t now_us,
+                                       uint32_t resolution_hz,
+                                       freq_meter_result_t *res) {
+  uint32_t edges = snap->edges;
+  res->freq_hz = 0.0f;
+  res->period_us = 0.0f;
+  res->periods = 0;
+
+  if (edges != rd->seen_edges) {
+    rd->seen_edges = edges;
+    rd->last_change_us = now_us;
+  } else if (now_us - rd->last_change_us >= rd->timeout_us) {
+    // Entrada parada: los timestamps viejos ya no sirven para promediar
+    rd->base_edges = edges;
+    res->status = FREQ_METER_TIMEOUT;
+    return res->status;
+  }
+
+  uint32_t valid = edges - rd->base_edges;
+  if (valid < 2) {
+    res->status = FREQ_METER_NO_DATA;
+    return res->status;
+  }
+  uint32_t periods = valid - 1;
+  if (periods > rd->avg_periods) {
+    periods = rd->avg_periods;
+  }
+  uint32_t last = snap->ts[(edges - 1) & (FREQ_METER_RING - 1)];
+  uint32_t first = snap->ts[(edges - 1 - periods) & (FREQ_METER_RING - 1)];
+  uint32_t span = last - first; // Correcto aunque el contador desborde
+  if (span == 0) {
+    res->status = FREQ_METER_NO_DATA;
+    return res->status;
+  }
+
+  res->freq_hz = (float)periods * resolution_hz / span;
+  res->period_us = (float)span * 1e6f / ((float)resolution_hz * periods);
+  res->periods = (uint16_t)periods;
+  res->status = FREQ_METER_OK;
+  return res->status;
+}
@@ -0,0 +1,236 @@
+/**
+ * @file main.c
+ * @brief Frecuencimetro / tacometro multicanal con captura MCPWM
+ *
+ * Aplicación real: medir trenes de pulsos de caudalimetros, tacometros de
+ * ventilador y encoders a frecuencias de kHz
+ * - El polling con gpio_get_level (06_gpio_input) pierde pulsos y una cola
+ *   por flanco (07_gpio_interrupciones) satura la CPU a kHz
+ * - Aqui cada flanco lo marca el hardware: el timer de captura MCPWM guarda
+ *   el valor del contador (80 MHz, 12.5 ns) en el instante del flanco
+ * - La ISR solo copia ese timestamp a un buffer circular (freq_meter.h)
+ * - Una tarea calcula la frecuencia reciproca promediando N periodos y
+ *   detecta entradas paradas por timeout (frecuencia cero)
+ * - 3 canales simultaneos (un timer de captura, 3 canales por grupo)
+ *
+ * Benchmark de carga de interrupciones (en cada arranque, sin cables):
+ *   - LEDC genera 10 kHz en el propio pin de CH0 (GPIO25) y la captura lo
+ *     lee por el lazo interno del GPIO (io_loop_back)
+ *   - Al terminar el pin vuelve a ser solo entrada para el sensor real.
+ *     Durante ese segundo el ESP32 conduce GPIO25: si el sensor de CH0 no
+ *     tolera una salida push-pull, poner BENCH_ENABLE a 0
+ *   - Se cuenta cuanto trabajo hace un bucle ocupado en el mismo core con y
+ *     sin senal: la diferencia es la carga de la ISR de captura
+ *
+ * Hardware:
+ *   - Salidas open-collector (tacometros): se habilita pull-up interno, para
+ *     cables largos usar pull-up externo de 4.7k a 3.3V
+ *
+ * Referencia oficial:
+ *   https://docs.espressif.com/projects/esp-idf/en/stable/esp32/api-reference/peripherals/mcpwm.html#capture
+ */
+#include "driver/mcpwm_cap.h"
+#include "esp_attr.h"
+#include "freertos/projdefs.h"
+#include "freq_meter.h"
+#include "hal/ledc_types.h"
+#include <driver/gpio.h>
+#include <driver/ledc.h>
+#include <esp_err.h>
+#include <esp_log.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <stdint.h>
+#include <stdio.h>
+
+static const char *TAG = "FREQ_METER";
+
+#define FREQ_TIMEOUT_US 1000000 // Sin flancos 1 s -> 0 Hz
+#define FREQ_REPORT_MS 500
+
+// Benchmark: senal de prueba de 10 kHz generada con LEDC sobre CH0
+#define BENCH_ENABLE 1
+#define BENCH_SIGNAL_HZ 10000
+#define BENCH_MS 1000
+
+// Configuracion de cada canal de captura
+typedef struct {
+  gpio_num_t gpio;
+  const char *name;
+  uint16_t avg_periods; // Periodos a promediar
+  float scale;          // Hz -> unidad de ingenieria
+  const char *unit;
+} freq_channel_cfg_t;
+
+static const freq_channel_cfg_t channel_cfg[] = {
+    {GPIO_NUM_25, "ventilador", 8, 60.0f / 2, "RPM"}, // 2 pulsos/vuelta
+    {GPIO_NUM_26, "caudal", 4, 1.0f / 7.5f, "L/min"}, // YF-S201: f/7.5
+    {GPIO_NUM_27, "encoder", 16, 60.0f / 600, "RPM"}, // 600 PPR
+};
+#define NUM_CHANNELS (sizeof(channel_cfg) / sizeof(channel_cfg[0]))
+
+static mcpwm_cap_timer_handle_t cap_timer = NULL;
+static mcpwm_cap_channel_handle_t cap_channels[NUM_CHANNELS];
+static uint32_t cap_resolution_hz = 0;
+
+// Timestamps escritos por la ISR, protegidos con spinlock para la copia
+static freq_meter_chan_t meters[NUM_CHANNELS];
+static portMUX_TYPE meter_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// ISR de captura: solo guarda el timestamp de hardware del flanco
+static bool IRAM_ATTR on_capture(mcpwm_cap_channel_handle_t cap_chan,
+                                 const mcpwm_capture_event_data_t *edata,
+                                 void *user_data) {
+  freq_meter_chan_t *meter = (freq_meter_chan_t *)user_data;
+  portENTER_CRITICAL_ISR(&meter_lock);
+  freq_meter_push_edge(meter, edata->cap_value);
+  portEXIT_CRITICAL_ISR(&meter_lock);
+  return false;
+}
+
+static esp_err_t freq_capture_init(void) {
+  mcpwm_capture_timer_config_t timer_conf = {
+      .clk_src = MCPWM_CAPTURE_CLK_SRC_DEFAULT, .group_id = 0};
+  ESP_ERROR_CHECK(mcpwm_new_capture_timer(&timer_conf, &cap_timer));
+  ESP_ERROR_CHECK(
+      mcpwm_capture_timer_get_resolution(cap_timer, &cap_resolution_hz));
+
+  for (int i = 0; i < NUM_CHANNELS; i++) {
+    freq_meter_chan_init(&meters[i]);
+    mcpwm_capture_channel_config_t chan_conf = {
+        .gpio_num = channel_cfg[i].gpio,
+        .prescale = 1,
+        .flags.pos_edge = true,
+        .flags.neg_edge = false,
+        // El benchmark inyecta su senal por la salida del pin de CH0
+        .flags.io_loop_back = BENCH_ENABLE && i == 0};
+    ESP_ERROR_CHECK(
+        mcpwm_new_capture_channel(cap_timer, &chan_conf, &cap_channels[i]));
+    gpio_pullup_en(channel_cfg[i].gpio);
+
+    mcpwm_capture_event_callbacks_t cbs = {.on_cap = on_capture};
+    ESP_ERROR_CHECK(mcpwm_capture_channel_register_event_callbacks(
+        cap_channels[i], &cbs, &meters[i]));
+    ESP_ERROR_CHECK(mcpwm_capture_channel_enable(cap_channels[i]));
+  }
+
+  ESP_ERROR_CHECK(mcpwm_capture_timer_enable(cap_timer));
+  ESP_ERROR_CHECK(mcpwm_capture_timer_start(cap_timer));
+  ESP_LOGI(TAG, "Captura MCPWM iniciada: %d canales, resolucion %lu Hz",
+           (int)NUM_CHANNELS, cap_resolution_hz);
+  return ESP_OK;
+}
+
+// Copia consistente de un canal (la ISR puede estar escribiendo)
+static void meter_snapshot(int idx, freq_meter_chan_t *snap) {
+  portENTER_CRITICAL(&meter_lock);
+  *snap = meters[idx];
+  portEXIT_CRITICAL(&meter_lock);
+}
+
+static void report_task(void *arg) {
+  freq_meter_reader_t readers[NUM_CHANNELS];
+  uint64_t now = esp_timer_get_time();
+  for (int i = 0; i < NUM_CHANNELS; i++) {
+    freq_meter_reader_init(&readers[i], channel_cfg[i].avg_periods,
+                           FREQ_TIMEOUT_US, now);
+  }
+
+  freq_meter_chan_t snap;
+  freq_meter_result_t res;
+  for (;;) {
+    vTaskDelay(pdMS_TO_TICKS(FREQ_REPORT_MS));
+    now = esp_timer_get_time();
+    for (int i = 0; i < NUM_CHANNELS; i++) {
+      meter_snapshot(i, &snap);
+      switch (freq_meter_compute(&snap, &readers[i], now, cap_resolution_hz,
+                                 &res)) {
+      case FREQ_METER_OK:
+        ESP_LOGI(TAG, "%s: %.3f Hz (T=%.1f us, N=%u) -> %.1f %s",
+                 channel_cfg[i].name, res.freq_hz, res.period_us, res.periods,
+                 res.freq_hz * channel_cfg[i].scale, channel_cfg[i].unit);
+        break;
+      case FREQ_METER_TIMEOUT:
+        ESP_LOGW(TAG, "%s: sin pulsos (0 %s)", channel_cfg[i].name,
+                 channel_cfg[i].unit);
+        break;
+      default:
+        ESP_LOGD(TAG, "%s: esperando flancos", channel_cfg[i].name);
+        break;
+      }
+    }
+  }
+}
+
+#if BENCH_ENABLE
+// Trabajo que hace la CPU en un bucle ocupado durante ms milisegundos
+static uint32_t busy_loop_count(uint32_t ms) {
+  uint64_t end = esp_timer_get_time() + (uint64_t)ms * 1000;
+  uint32_t count = 0;
+  while (esp_timer_get_time() < end) {
+    count++;
+  }
+  return count;
+}
+
+// Carga de la ISR de captura con una entrada de 10 kHz en CH0. LEDC saca la
+// senal por el mismo GPIO que lee la captura: no hace falta puente externo
+static void bench_interrupt_load(void) {
+  const gpio_num_t pin = channel_cfg[0].gpio;
+  ledc_timer_config_t ledc_timer = {.speed_mode = LEDC_LOW_SPEED_MODE,
+                                    .timer_num = LEDC_TIMER_0,
+                                    .duty_resolution = LEDC_TIMER_8_BIT,
+                                    .freq_hz = BENCH_SIGNAL_HZ,
+                                    .clk_cfg = LEDC_AUTO_CLK};
+  ESP_ERROR_CHECK(ledc_timer_config(&ledc_timer));
+  ledc_channel_config_t ledc_channel = {.speed_mode = LEDC_LOW_SPEED_MODE,
+                                        .channel = LEDC_CHANNEL_0,
+                                        .timer_sel = LEDC_TIMER_0,
+                                        .intr_type = LEDC_INTR_DISABLE,
+                                        .gpio_num = pin,
+                                        .duty = 0,
+                                        .hpoint = 0};
+  ESP_ERROR_CHECK(ledc_channel_config(&ledc_channel));
+  // LEDC deja el pin solo como salida: volver a habilitar la entrada para
+  // que la senal llegue a la captura por el GPIO matrix
+  ESP_ERROR_CHECK(gpio_set_direction(pin, GPIO_MODE_INPUT_OUTPUT));
+
+  // app_main corre en el mismo core donde se instalo la ISR de captura
+  uint32_t edges_before = meters[0].edges;
+  uint32_t idle = busy_loop_count(BENCH_MS);
+  uint32_t idle_edges = meters[0].edges - edges_before;
+
+  ESP_ERROR_CHECK(ledc_set_duty(LEDC_LOW_SPEED_MODE, LEDC_CHANNEL_0, 128));
+  ESP_ERROR_CHECK(ledc_update_duty(LEDC_LOW_SPEED_MODE, LEDC_CHANNEL_0));
+  vTaskDelay(pdMS_TO_TICKS(10));
+  uint32_t edges_start = meters[0].edges;
+  uint32_t loaded = busy_loop_count(BENCH_MS);
+  uint32_t edges = meters[0].edges - edges_start;
+
+  // Liberar el pin para el sensor real: sin salida, la captura sigue
+  // conectada a la entrada (con su pull-up)
+  ESP_ERROR_CHECK(ledc_stop(LEDC_LOW_SPEED_MODE, LEDC_CHANNEL_0, 0));
+  ESP_ERROR_CHECK(gpio_set_direction(pin, GPIO_MODE_INPUT));
+
+  if (edges == 0) {
+    ESP_LOGE(TAG, "Benchmark: la senal LEDC no llega a la captura de GPIO%d",
+             pin);
+    return;
+  }
+  float load = 1.0f - (float)loaded / idle;
+  ESP_LOGI(TAG,
+           "Benchmark %d Hz: %lu flancos/s (%lu en reposo), carga ISR %.2f%%, "
+           "%.2f us por flanco",
+           BENCH_SIGNAL_HZ, edges * 1000 / BENCH_MS, idle_edges, load * 100.0f,
+           load * BENCH_MS * 1000.0f / edges);
+}
+#endif
+
+void app_main() {
+  ESP_ERROR_CHECK(freq_capture_init());
+#if BENCH_ENABLE
+  bench_interrupt_load();
+#endif
+  xTaskCreate(report_task, "report_task", 4096, NULL, 5, NULL);
+}
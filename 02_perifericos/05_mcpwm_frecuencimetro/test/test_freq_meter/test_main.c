@@ -0,0 +1,140 @@
+// Tests en el PC del calculo de frecuencia reciproca (pio test -e native)
+#include "freq_meter.h"
+#include <stdint.h>
+#include <unity.h>
+
+#define RES_HZ 80000000UL // Timer de captura MCPWM a 80 MHz
+#define TIMEOUT_US 1000000ULL
+
+static freq_meter_chan_t ch;
+static freq_meter_reader_t rd;
+static freq_meter_result_t res;
+
+void setUp(void) {
+  freq_meter_chan_init(&ch);
+  freq_meter_reader_init(&rd, 8, TIMEOUT_US, 0);
+}
+
+void tearDown(void) {}
+
+// Empuja n flancos separados period ticks y devuelve el siguiente timestamp
+static uint32_t push_edges(uint32_t ts, uint32_t period, int n) {
+  for (int i = 0; i < n; i++) {
+    freq_meter_push_edge(&ch, ts);
+    ts += period;
+  }
+  return ts;
+}
+
+void test_no_data_without_two_edges(void) {
+  TEST_ASSERT_EQUAL_INT(FREQ_METER_NO_DATA,
+                        freq_meter_compute(&ch, &rd, 10, RES_HZ, &res));
+  push_edges(1000, 8000, 1);
+  TEST_ASSERT_EQUAL_INT(FREQ_METER_NO_DATA,
+                        freq_meter_compute(&ch, &rd, 20, RES_HZ, &res));
+  TEST_ASSERT_FLOAT_WITHIN(0.0f, 0.0f, res.freq_hz);
+  TEST_ASSERT_EQUAL_UINT16(0, res.periods);
+}
+
+void test_no_data_on_zero_span(void) {
+  push_edges(5000, 0, 2); // Dos flancos con el mismo timestamp
+  TEST_ASSERT_EQUAL_INT(FREQ_METER_NO_DATA,
+                        freq_meter_compute(&ch, &rd, 10, RES_HZ, &res));
+}
+
+void test_reciprocal_frequency_10khz(void) {
+  push_edges(0, 8000, 20); // 80 MHz / 8000 = 10 kHz
+  TEST_ASSERT_EQUAL_INT(FREQ_METER_OK,
+                        freq_meter_compute(&ch, &rd, 10, RES_HZ, &res));
+  TEST_ASSERT_FLOAT_WITHIN(1e-3f, 10000.0f, res.freq_hz);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 100.0f, res.period_us);
+}
+
+void test_counter_wraparound(void) {
+  // Los periodos cruzan 0xFFFFFFFF -> 0
+  push_edges(0xFFFFFFFFu - 3 * 8000 + 1, 8000, 8);
+  TEST_ASSERT_EQUAL_INT(FREQ_METER_OK,
+                        freq_meter_compute(&ch, &rd, 10, RES_HZ, &res));
+  TEST_ASSERT_EQUAL_UINT16(7, res.periods);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3f, 10000.0f, res.freq_hz);
+}
+
+void test_averaging_clamped_to_avg_periods(void) {
+  // Periodos alternos de 7990 y 8010 ticks: el promedio de un numero par
+  // de periodos es exactamente 8000
+  uint32_t ts = 0;
+  for (int i = 0; i < 3; i++) {
+    freq_meter_push_edge(&ch, ts);
+    ts += (i & 1) ? 8010 : 7990;
+  }
+  freq_meter_compute(&ch, &rd, 10, RES_HZ, &res);
+  TEST_ASSERT_EQUAL_UINT16(2, res.periods); // Menos flancos que avg_periods
+
+  for (int i = 3; i < 40; i++) {
+    freq_meter_push_edge(&ch, ts);
+    ts += (i & 1) ? 8010 : 7990;
+  }
+  freq_meter_compute(&ch, &rd, 20, RES_HZ, &res);
+  TEST_ASSERT_EQUAL_UINT16(8, res.periods); // Limitado a avg_periods
+  TEST_ASSERT_FLOAT_WITHIN(1e-3f, 10000.0f, res.freq_hz);
+}
+
+void test_avg_periods_clamped_to_ring(void) {
+  freq_meter_reader_init(&rd, 500, TIMEOUT_US, 0);
+  TEST_ASSERT_EQUAL_UINT16(FREQ_METER_MAX_AVG, rd.avg_periods);
+  freq_meter_reader_init(&rd, 0, TIMEOUT_US, 0);
+  TEST_ASSERT_EQUAL_UINT16(1, rd.avg_periods);
+
+  freq_meter_reader_init(&rd, FREQ_METER_MAX_AVG, TIMEOUT_US, 0);
+  push_edges(0, 8000, 3 * FREQ_METER_RING); // El buffer da varias vueltas
+  freq_meter_compute(&ch, &rd, 10, RES_HZ, &res);
+  TEST_ASSERT_EQUAL_UINT16(FREQ_METER_MAX_AVG, res.periods);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3f, 10000.0f, res.freq_hz);
+}
+
+void test_timeout_reports_zero_frequency(void) {
+  push_edges(0, 8000, 10);
+  TEST_ASSERT_EQUAL_INT(FREQ_METER_OK,
+                        freq_meter_compute(&ch, &rd, 1000, RES_HZ, &res));
+  // Sin flancos nuevos, pero aun dentro del timeout: ultima medida
+  TEST_ASSERT_EQUAL_INT(FREQ_METER_OK, freq_meter_compute(
+                                           &ch, &rd, 1000 + TIMEOUT_US - 1,
+                                           RES_HZ, &res));
+  TEST_ASSERT_EQUAL_INT(FREQ_METER_TIMEOUT,
+                        freq_meter_compute(&ch, &rd, 1000 + TIMEOUT_US,
+                                           RES_HZ, &res));
+  TEST_ASSERT_FLOAT_WITHIN(0.0f, 0.0f, res.freq_hz);
+  TEST_ASSERT_FLOAT_WITHIN(0.0f, 0.0f, res.period_us);
+  TEST_ASSERT_EQUAL_UINT32(10, rd.base_edges);
+}
+
+void test_restart_after_timeout_ignores_stale_edges(void) {
+  uint32_t ts = push_edges(0, 8000, 10); // 10 kHz
+  freq_meter_compute(&ch, &rd, 1000, RES_HZ, &res);
+  freq_meter_compute(&ch, &rd, 1000 + TIMEOUT_US, RES_HZ, &res);
+  TEST_ASSERT_EQUAL_INT(FREQ_METER_TIMEOUT, res.status);
+
+  // La entrada vuelve a 1 kHz tras 2 s parada
+  ts += 2 * RES_HZ;
+  ts = push_edges(ts, 80000, 1);
+  TEST_ASSERT_EQUAL_INT(FREQ_METER_NO_DATA,
+                        freq_meter_compute(&ch, &rd, 3000000, RES_HZ, &res));
+  push_edges(ts, 80000, 1);
+  TEST_ASSERT_EQUAL_INT(FREQ_METER_OK,
+                        freq_meter_compute(&ch, &rd, 3001000, RES_HZ, &res));
+  TEST_ASSERT_EQUAL_UINT16(1, res.periods); // El hueco no se promedia
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 1000.0f, res.freq_hz);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_no_data_without_two_edges);
+  RUN_TEST(test_no_data_on_zero_span);
+  RUN_TEST(test_reciprocal_frequency_10khz);
+  RUN_TEST(test_counter_wraparound);
+  RUN_TEST(test_averaging_clamped_to_avg_periods);
+  RUN_TEST(test_avg_periods_clamped_to_ring);
+  RUN_TEST(test_timeout_reports_zero_frequency);
+  RUN_TEST(test_restart_after_timeout_ignores_stale_edges);
+  return UNITY_END();
+}